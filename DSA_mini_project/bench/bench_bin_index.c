@@ -0,0 +1,75 @@
+// Lookup / update throughput of the binID hash index as the fleet grows.
+// Compares findBinByID against the old linear list walk it replaced.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "core.h"
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// What findBinByID used to do
+static Dustbin* linearFind(int id) {
+    Dustbin* current = head;
+    while (current) {
+        if (current->binID == id) return current;
+        current = current->next;
+    }
+    return NULL;
+}
+
+static void runFleet(int bins) {
+    const int lookups = 1000000;
+    const int scans = 2000;
+    const int updates = 2000;
+    volatile long sink = 0;
+
+    double t0 = nowSeconds();
+    for (int i = 1; i <= bins; i++) {
+        // Stay below 90% so every bin lands in the normal queue
+        addBin(i, "Bench", (float)(i % 200) / 10.0f, rand() % 90);
+    }
+    double addTime = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (int i = 0; i < lookups; i++) {
+        Dustbin* b = findBinByID(1 + rand() % bins);
+        sink += b->fillLevel;
+    }
+    double hashTime = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (int i = 0; i < scans; i++) {
+        Dustbin* b = linearFind(1 + rand() % bins);
+        sink += b->fillLevel;
+    }
+    double scanTime = nowSeconds() - t0;
+
+    t0 = nowSeconds();
+    for (int i = 0; i < updates; i++) {
+        updateFillLevel(1 + rand() % bins, rand() % 90);
+    }
+    double updateTime = nowSeconds() - t0;
+
+    printf("%9d %12.1f %12.1f %12.1f %14.1f\n", bins,
+           addTime * 1e9 / bins,
+           hashTime * 1e9 / lookups,
+           scanTime * 1e9 / scans,
+           updateTime * 1e9 / updates);
+
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+    (void)sink;
+}
+
+int main(void) {
+    srand(42);
+    printf("%9s %12s %12s %12s %14s\n", "bins", "add ns/op", "find ns/op", "scan ns/op", "update ns/op");
+    int sizes[] = {1000, 10000, 100000};
+    for (int i = 0; i < 3; i++) runFleet(sizes[i]);
+    return 0;
+}
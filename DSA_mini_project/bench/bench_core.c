@@ -0,0 +1,169 @@
+// Core operation microbenchmarks across fleet sizes.
+// Reports ns/op, heap allocations/op and peak RSS per operation and size,
+// and writes the same numbers as JSON (default bench_core.json, or argv[1])
+// so runs from different releases can be diffed.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "core.h"
+#include "log.h"
+#include "mempool.h"
+
+#define AREA_COUNT 100
+#define MAX_RESULTS 64
+
+typedef struct BenchResult {
+    const char* op;
+    int bins;
+    long iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    long peakRssKB;
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static char areaNames[AREA_COUNT][16];
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static long peakRssKB(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static unsigned long heapAllocs(void) {
+    const AllocStats* stats = getAllocStats();
+    return stats->mallocs + stats->reallocs;
+}
+
+static double timerStart;
+static unsigned long allocStart;
+
+static void beginOp(void) {
+    allocStart = heapAllocs();
+    timerStart = nowSeconds();
+}
+
+static void endOp(const char* op, int bins, long iterations) {
+    double elapsed = nowSeconds() - timerStart;
+    if (resultCount == MAX_RESULTS) return;
+    BenchResult* r = &results[resultCount++];
+    r->op = op;
+    r->bins = bins;
+    r->iterations = iterations;
+    r->nsPerOp = elapsed * 1e9 / iterations;
+    r->allocsPerOp = (double)(heapAllocs() - allocStart) / iterations;
+    r->peakRssKB = peakRssKB();
+}
+
+static void runFleet(int bins) {
+    // Per-bin operations repeat up to 100k times; whole-fleet passes run
+    // enough times to add up to about 1M bins touched, with at least 3.
+    long pointOps = bins < 100000 ? bins : 100000;
+    long fleetPasses = 1000000 / bins;
+    if (fleetPasses < 3) fleetPasses = 3;
+    volatile long sink = 0;
+
+    beginOp();
+    for (int i = 1; i <= bins; i++) {
+        addBin(i, areaNames[i % AREA_COUNT], (float)(i % 200) / 10.0f, rand() % 101);
+    }
+    endOp("addBin", bins, bins);
+
+    beginOp();
+    for (long i = 0; i < pointOps; i++) {
+        Dustbin* b = findBinByID(1 + rand() % bins);
+        sink += b->fillLevel;
+    }
+    endOp("findBinByID", bins, pointOps);
+
+    beginOp();
+    for (long i = 0; i < pointOps; i++) {
+        updateFillLevel(1 + rand() % bins, rand() % 101);
+    }
+    endOp("updateFillLevel", bins, pointOps);
+
+    beginOp();
+    for (long i = 0; i < fleetPasses; i++) queueBinsByDistance();
+    endOp("queueBinsByDistance", bins, fleetPasses);
+
+    beginOp();
+    for (long i = 0; i < fleetPasses; i++) simulateFillLevelIncrease();
+    endOp("simulateFillLevelIncrease", bins, fleetPasses);
+
+    beginOp();
+    for (long i = 0; i < fleetPasses; i++) simulateTruckCollection();
+    endOp("simulateTruckCollection", bins, fleetPasses);
+
+    // 7919 is prime, so this visits distinct IDs in a scattered order
+    beginOp();
+    for (long i = 0; i < pointOps; i++) {
+        deleteBin(1 + (int)((i * 7919) % bins));
+    }
+    endOp("deleteBin", bins, pointOps);
+
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+
+    (void)sink;
+}
+
+static int writeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 0;
+    }
+    fprintf(out, "{\n  \"benchmark\": \"bench_core\",\n  \"results\": [\n");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(out, "    {\"op\": \"%s\", \"bins\": %d, \"iterations\": %ld, "
+                     "\"ns_per_op\": %.1f, \"allocs_per_op\": %.4f, \"peak_rss_kb\": %ld}%s\n",
+                r->op, r->bins, r->iterations, r->nsPerOp, r->allocsPerOp, r->peakRssKB,
+                i + 1 < resultCount ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = argc > 1 ? argv[1] : "bench_core.json";
+    srand(42);
+    for (int i = 0; i < AREA_COUNT; i++) {
+        snprintf(areaNames[i], sizeof(areaNames[i]), "Area%02d", i);
+    }
+
+    // Core messages still go through the log ring (default level), but
+    // the writer sends them to /dev/null instead of the terminal
+    FILE* devnull = fopen("/dev/null", "w");
+    if (devnull) logSetOutput(devnull);
+
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    for (int i = 0; i < 4; i++) runFleet(sizes[i]);
+
+    logSetOutput(NULL);
+    if (devnull) fclose(devnull);
+
+    printf("%-26s %9s %14s %12s %12s\n", "operation", "bins", "ns/op", "allocs/op", "peak RSS KB");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        printf("%-26s %9d %14.1f %12.4f %12ld\n", r->op, r->bins, r->nsPerOp, r->allocsPerOp, r->peakRssKB);
+    }
+    if (!writeJson(jsonPath)) return 1;
+    printf("\nResults written to %s\n", jsonPath);
+    return 0;
+}
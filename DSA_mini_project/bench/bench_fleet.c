@@ -0,0 +1,124 @@
+// Fleet dispatch latency as trucks and bins grow.
+// Each case loads a fresh fleet of bins over 500 areas, sends every truck
+// out once with the dispatch budget simulateTruckCollection uses, and
+// reports the wall time of dispatchFleet (assignment, tour planning and
+// collection) plus how much work the trucks took on. Results are also
+// written as JSON (default bench_fleet.json, or argv[1]).
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "core.h"
+#include "fleet.h"
+#include "log.h"
+
+#define AREA_COUNT 500
+#define PLAN_BUDGET_US 20000
+#define MAX_RESULTS 32
+
+typedef struct BenchResult {
+    int trucks;
+    int bins;
+    double msPerDispatch;
+    int trucksSent;
+    int binsCollected;
+    double km;
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static char areaNames[AREA_COUNT][16];
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void runCase(int trucks, int bins) {
+    if (resultCount == MAX_RESULTS) return;
+    // Area distances come from the first bin added to each area
+    for (int i = 1; i <= bins; i++) {
+        int area = rand() % AREA_COUNT;
+        addBin(i, areaNames[area], 1.0f + (float)(area * 37 % 2400) / 100.0f, rand() % 101);
+    }
+    for (int t = 0; t < trucks; t++) {
+        Truck truck = {0};
+        truck.id = t + 1;
+        truck.capacity = 20.0f;
+        truck.speedKmph = DEFAULT_TRUCK_SPEED_KMPH;
+        truck.shiftMinutes = DEFAULT_TRUCK_SHIFT_MINUTES;
+        truck.loadMinutes = 1.5f;
+        fleetAddTruck(&truck);
+    }
+    queueBinsByDistance();
+
+    double t0 = nowSeconds();
+    int sent = dispatchFleet(PLAN_BUDGET_US);
+    double elapsed = nowSeconds() - t0;
+
+    BenchResult* r = &results[resultCount++];
+    r->trucks = trucks;
+    r->bins = bins;
+    r->msPerDispatch = elapsed * 1e3;
+    r->trucksSent = sent;
+    r->binsCollected = 0;
+    r->km = 0;
+    for (int i = 0; i < sent; i++) {
+        r->binsCollected += getDispatchSummary(i)->binsCollected;
+        r->km += getDispatchSummary(i)->totalKm;
+    }
+
+    fleetClear();
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+}
+
+static int writeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 0;
+    }
+    fprintf(out, "{\n  \"benchmark\": \"bench_fleet\",\n  \"budget_us\": %d,\n  \"results\": [\n", PLAN_BUDGET_US);
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(out, "    {\"trucks\": %d, \"bins\": %d, \"ms_per_dispatch\": %.3f, "
+                     "\"trucks_sent\": %d, \"bins_collected\": %d, \"km\": %.1f}%s\n",
+                r->trucks, r->bins, r->msPerDispatch, r->trucksSent, r->binsCollected, r->km,
+                i + 1 < resultCount ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = argc > 1 ? argv[1] : "bench_fleet.json";
+    srand(42);
+    for (int i = 0; i < AREA_COUNT; i++) {
+        snprintf(areaNames[i], sizeof(areaNames[i]), "Area%03d", i);
+    }
+
+    FILE* devnull = fopen("/dev/null", "w");
+    if (devnull) logSetOutput(devnull);
+
+    int truckCounts[] = {10, 100, 500};
+    int binCounts[] = {10000, 100000};
+    for (int b = 0; b < 2; b++) {
+        for (int t = 0; t < 3; t++) runCase(truckCounts[t], binCounts[b]);
+    }
+
+    logSetOutput(NULL);
+    if (devnull) fclose(devnull);
+
+    printf("%7s %9s %14s %12s %14s %10s\n", "trucks", "bins", "ms/dispatch", "trucks sent", "bins collected", "km");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        printf("%7d %9d %14.3f %12d %14d %10.1f\n", r->trucks, r->bins, r->msPerDispatch,
+               r->trucksSent, r->binsCollected, r->km);
+    }
+    if (!writeJson(jsonPath)) return 1;
+    printf("\nResults written to %s\n", jsonPath);
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Route planning latency against the number of stops.
+// Each size is planned with no improvement (nearest neighbour only), with
+// the budget a dispatch uses, and with a budget large enough to reach a
+// local optimum, reporting time per plan and tour length. Results are also
+// written as JSON (default bench_route_planner.json, or argv[1]).
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "area_table.h"
+#include "route_planner.h"
+
+#define MAX_STOPS 512
+#define MAX_RESULTS 64
+
+typedef struct BenchResult {
+    int stops;
+    long budgetMicros;
+    int plans;
+    double msPerPlan;
+    double km;
+    double initialKm;
+    double improvements;
+    int timedOut;
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static int areaIds[MAX_STOPS];
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void shuffle(int* ids, int count) {
+    for (int i = count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = ids[i];
+        ids[i] = ids[j];
+        ids[j] = t;
+    }
+}
+
+static void runSize(int stops, long budgetMicros, int plans) {
+    int stopIds[MAX_STOPS];
+    int order[MAX_STOPS];
+    if (resultCount == MAX_RESULTS) return;
+    BenchResult* r = &results[resultCount++];
+    r->stops = stops;
+    r->budgetMicros = budgetMicros;
+    r->plans = plans;
+
+    double elapsed = 0;
+    for (int p = 0; p < plans; p++) {
+        // A different subset of the city each time
+        shuffle(areaIds, MAX_STOPS);
+        for (int i = 0; i < stops; i++) stopIds[i] = areaIds[i];
+
+        RouteResult route;
+        double t0 = nowSeconds();
+        planRoute(stopIds, stops, budgetMicros, order, &route);
+        elapsed += nowSeconds() - t0;
+
+        r->km += route.km;
+        r->initialKm += route.initialKm;
+        r->improvements += route.improvements;
+        r->timedOut += route.timedOut;
+    }
+    r->msPerPlan = elapsed * 1e3 / plans;
+    r->km /= plans;
+    r->initialKm /= plans;
+    r->improvements /= plans;
+}
+
+static int writeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 0;
+    }
+    fprintf(out, "{\n  \"benchmark\": \"bench_route_planner\",\n  \"results\": [\n");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(out, "    {\"stops\": %d, \"budget_us\": %ld, \"plans\": %d, \"ms_per_plan\": %.4f, "
+                     "\"km\": %.2f, \"initial_km\": %.2f, \"improvements\": %.1f, \"timed_out\": %d}%s\n",
+                r->stops, r->budgetMicros, r->plans, r->msPerPlan, r->km, r->initialKm,
+                r->improvements, r->timedOut, i + 1 < resultCount ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = argc > 1 ? argv[1] : "bench_route_planner.json";
+    srand(42);
+
+    // Same distance range as initializeRandomBins
+    for (int i = 0; i < MAX_STOPS; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "Stop%03d", i);
+        areaIds[i] = areaIntern(name);
+        areaSetDistance(areaIds[i], 1.0f + (float)(rand() % 2400) / 100.0f);
+    }
+
+    int sizes[] = {4, 8, 16, 32, 64, 128, 256, 512};
+    long budgets[] = {0, 2000, 1000000};
+    for (int s = 0; s < 8; s++) {
+        for (int b = 0; b < 3; b++) {
+            int plans = sizes[s] <= 64 ? 200 : 10;
+            runSize(sizes[s], budgets[b], plans);
+        }
+    }
+
+    printf("%6s %10s %7s %12s %10s %12s %10s %9s\n",
+           "stops", "budget us", "plans", "ms/plan", "km", "NN km", "moves", "timeouts");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        printf("%6d %10ld %7d %12.4f %10.1f %12.1f %10.1f %9d\n", r->stops, r->budgetMicros, r->plans,
+               r->msPerPlan, r->km, r->initialKm, r->improvements, r->timedOut);
+    }
+    areaTableFree();
+    if (!writeJson(jsonPath)) return 1;
+    printf("\nResults written to %s\n", jsonPath);
+    return 0;
+}
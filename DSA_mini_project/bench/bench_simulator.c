@@ -0,0 +1,118 @@
+// Discrete-event simulation throughput.
+// Each case loads a fresh fleet of bins over 500 areas and a fleet of
+// trucks, runs weeks of operation with the default simulation settings
+// (hourly sensor reports, 06:00 shifts, a dispatch every 30 minutes) and
+// reports events per second alongside the operating KPIs it produced.
+// Results are also written as JSON (default bench_simulator.json, or argv[1]).
+#include <stdio.h>
+#include <stdlib.h>
+#include "core.h"
+#include "fleet.h"
+#include "simulator.h"
+#include "log.h"
+
+#define AREA_COUNT 500
+#define MAX_RESULTS 16
+
+typedef struct BenchResult {
+    int bins;
+    int trucks;
+    int days;
+    SimKpis kpis;
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static char areaNames[AREA_COUNT][16];
+
+static void runCase(int bins, int trucks, int days) {
+    if (resultCount == MAX_RESULTS) return;
+    for (int i = 1; i <= bins; i++) {
+        int area = rand() % AREA_COUNT;
+        addBin(i, areaNames[area], 1.0f + (float)(area * 37 % 2400) / 100.0f, rand() % 101);
+    }
+    for (int t = 0; t < trucks; t++) {
+        Truck truck = {0};
+        truck.id = t + 1;
+        truck.capacity = 100.0f;
+        truck.speedKmph = DEFAULT_TRUCK_SPEED_KMPH;
+        truck.shiftMinutes = DEFAULT_TRUCK_SHIFT_MINUTES;
+        truck.loadMinutes = 0.5f;
+        fleetAddTruck(&truck);
+    }
+
+    SimConfig config;
+    simConfigDefaults(&config);
+    config.days = days;
+    // Bins take one to four weeks to fill, so the fleet can keep up
+    config.minFillPerHour = 0.15f;
+    config.maxFillPerHour = 0.6f;
+
+    BenchResult* r = &results[resultCount++];
+    r->bins = bins;
+    r->trucks = trucks;
+    r->days = days;
+    runSimulation(&config, &r->kpis);
+
+    fleetClear();
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+}
+
+static int writeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 0;
+    }
+    fprintf(out, "{\n  \"benchmark\": \"bench_simulator\",\n  \"results\": [\n");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        const SimKpis* k = &r->kpis;
+        fprintf(out, "    {\"bins\": %d, \"trucks\": %d, \"days\": %d, \"events\": %lu, "
+                     "\"wall_s\": %.3f, \"events_per_s\": %.0f, \"speedup\": %.0f, "
+                     "\"fill_ticks\": %lu, \"departures\": %lu, \"arrivals\": %lu, \"unloads\": %lu, \"late_returns\": %lu, "
+                     "\"bins_collected\": %ld, \"km\": %.1f, \"overflows\": %ld, "
+                     "\"overflow_minutes\": %.0f}%s\n",
+                r->bins, r->trucks, r->days, k->events, k->wallSeconds, k->eventsPerSecond,
+                k->wallSeconds > 0 ? k->simulatedMinutes * 60.0 / k->wallSeconds : 0.0,
+                k->fillTicks, k->departures, k->arrivals, k->unloads, k->lateReturns,
+                k->binsCollected, k->kmDriven, k->overflows, k->overflowMinutes,
+                i + 1 < resultCount ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = argc > 1 ? argv[1] : "bench_simulator.json";
+    srand(42);
+    for (int i = 0; i < AREA_COUNT; i++) {
+        snprintf(areaNames[i], sizeof(areaNames[i]), "Area%03d", i);
+    }
+
+    FILE* devnull = fopen("/dev/null", "w");
+    if (devnull) logSetOutput(devnull);
+
+    runCase(10000, 12, 28);
+    runCase(100000, 24, 14);
+    runCase(100000, 48, 28);
+
+    logSetOutput(NULL);
+    if (devnull) fclose(devnull);
+
+    printf("%8s %7s %5s %11s %9s %12s %10s %10s %10s %14s\n", "bins", "trucks", "days", "events",
+           "wall s", "events/s", "collected", "km", "overflows", "overflow min");
+    for (int i = 0; i < resultCount; i++) {
+        const BenchResult* r = &results[i];
+        const SimKpis* k = &r->kpis;
+        printf("%8d %7d %5d %11lu %9.2f %12.0f %10ld %10.0f %10ld %14.0f\n", r->bins, r->trucks, r->days,
+               k->events, k->wallSeconds, k->eventsPerSecond, k->binsCollected, k->kmDriven,
+               k->overflows, k->overflowMinutes);
+    }
+    if (!writeJson(jsonPath)) return 1;
+    printf("\nResults written to %s\n", jsonPath);
+    return 0;
+}
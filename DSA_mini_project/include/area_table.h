@@ -0,0 +1,52 @@
+#ifndef AREA_TABLE_H
+#define AREA_TABLE_H
+
+struct Dustbin;
+
+// ----------------------------
+// Interned areas
+// ----------------------------
+// Every distinct area string gets a small dense integer id, so hot paths
+// can compare and index areas without strcmp. Each area also holds its
+// depot distance and an intrusive bucket of the bins located in it
+// (linked through Dustbin.areaNext/areaPrev).
+
+int areaIntern(const char* name);     // existing or new id, -1 on failure
+int areaLookup(const char* name);     // -1 if the name was never interned
+const char* areaName(int id);
+int areaCount(void);
+
+float areaDistance(int id);           // -1 if no distance was assigned
+void areaSetDistance(int id, float distance);
+void areaResetDistances(void);
+
+// Road distance between two areas, or between an area and the depot
+// (AREA_DEPOT). Only depot distances are recorded, so each area is placed
+// on a plane at its depot distance, on a bearing spread by area id, and
+// legs between areas are the straight line between those points.
+#define AREA_DEPOT -1
+float areaTravelKm(int from, int to);
+// Same plane, from any point (km east/north of the depot) to an area
+float areaKmFromPoint(float x, float y, int id);
+// The point distance km from the depot on the area's bearing, moved offset
+// km sideways (positive is counter-clockwise)
+void areaPointAt(int id, float distance, float offset, float* x, float* y);
+// Changes whenever areas are added, moved or freed (distance_matrix.h
+// rebuilds from it)
+unsigned long areaGeometryVersion(void);
+
+void areaAttachBin(struct Dustbin* bin);
+void areaDetachBin(struct Dustbin* bin);
+struct Dustbin* areaFirstBin(int id);
+int areaBinCount(int id);
+void areaClearBins(void);
+
+// Running fill totals per area, kept by attach/detach plus this call after
+// an attached bin's fillLevel changes from oldFill
+void areaUpdateFill(const struct Dustbin* bin, int oldFill);
+long areaFillSum(int id);
+int areaUrgentCount(int id);          // bins at or above 90%
+
+void areaTableFree(void);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef BIN_INDEX_H
+#define BIN_INDEX_H
+
+#include <stddef.h>
+
+struct Dustbin;
+
+// ----------------------------
+// Hash index: binID -> Dustbin
+// ----------------------------
+// Open addressing with linear probing. Deletes use backward shifting
+// instead of tombstones, so probe chains stay short after heavy churn.
+
+typedef struct BinIndexSlot {
+    int binID;
+    struct Dustbin* bin;   // NULL marks an empty slot
+} BinIndexSlot;
+
+typedef struct BinIndex {
+    BinIndexSlot* slots;
+    size_t capacity;       // 0 or a power of two
+    size_t count;
+} BinIndex;
+
+struct Dustbin* binIndexFind(const BinIndex* index, int id);
+int binIndexInsert(BinIndex* index, struct Dustbin* bin);
+int binIndexRemove(BinIndex* index, int id);
+int binIndexReserve(BinIndex* index, size_t expected);
+void binIndexClear(BinIndex* index);
+void binIndexFree(BinIndex* index);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef BIN_STORE_H
+#define BIN_STORE_H
+
+struct Dustbin;
+
+// ----------------------------
+// Structure-of-arrays bin store
+// ----------------------------
+// Contiguous parallel arrays: the fill level of every Dustbin and the node
+// it belongs to. Row lookups go through owner; fill scans read the fill
+// column instead of chasing list pointers. Removal swaps the last slot
+// into the hole, so the arrays stay dense.
+
+typedef struct BinStore {
+    unsigned char* fill;       // 0-100, one byte each so SIMD covers 32 bins per step
+    struct Dustbin** owner;    // list node for each slot
+    int count;
+    int capacity;
+} BinStore;
+
+// Result of one pass over the fill column
+typedef struct FillScan {
+    int total;
+    int atLeast50;
+    int atLeast70;
+    int atLeast90;
+    int empty;
+} FillScan;
+
+int binStoreAdd(BinStore* store, struct Dustbin* bin);
+void binStoreRemove(BinStore* store, struct Dustbin* bin);
+void binStoreSync(BinStore* store, const struct Dustbin* bin);
+void binStoreScanFill(const BinStore* store, FillScan* out);
+void binStoreClear(BinStore* store);
+void binStoreFree(BinStore* store);
+
+#endif
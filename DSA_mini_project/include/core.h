@@ -14,33 +14,32 @@ typedef struct Dustbin {
     int fillLevel;
     int priority;
     struct Dustbin* next;
+    struct Dustbin* prev;   // lets deleteBin unlink in O(1)
+    int heapIndex;          // slot in the priority heap, -1 if not queued
+    int storeSlot;          // column index in the SoA bin store
+    int areaId;             // interned area (area_table.h)
+    struct Dustbin* areaNext;   // bins of the same area
+    struct Dustbin* areaPrev;
+    // Red-black links into the distance-ordered queue the bin sits in
+    // (normal queue, or the urgent-by-distance view); see distance_tree.h
+    struct Dustbin* rbLeft;
+    struct Dustbin* rbRight;
+    struct Dustbin* rbParent;
+    char rbRed;
+    int rbSize;             // nodes in this subtree, for rank/select
+    struct DistanceTree* rbTree;  // owning tree, NULL if not queued
+    float x, y;             // km east/north of the depot
+    struct Dustbin* gridNext;   // bins of the same spatial cell (spatial_index.h)
+    struct Dustbin* gridPrev;
 } Dustbin;
 
-// BST node for sorting bins by distance
-typedef struct BSTNode {
-    Dustbin* binptr;
-    struct BSTNode* left;
-    struct BSTNode* right;
-} BSTNode;
-
-// Normal queue node
-typedef struct queue {
-    int binID;
-    char area[50];
-    float distance;
-    int fillLevel;
-    int priority;
-    struct queue* next;
-} queue;
-
-// Priority queue node
+// Priority queue: array-backed binary max-heap of urgent bins ordered by
+// priority, ties served nearest first. Each bin tracks its own heap slot
+// (Dustbin.heapIndex), so enqueue, re-key and remove are all O(log n).
 typedef struct priorityqueue {
-    int binID;
-    char area[50];
-    float distance;
-    int fillLevel;
     int priority;
-    struct priorityqueue* next;
+    float distance;         // breaks priority ties
+    Dustbin* bin;
 } priorityqueue;
 
 // ----------------------------
@@ -49,10 +48,6 @@ typedef struct priorityqueue {
 // ----------------------------
 
 extern Dustbin* head;
-extern queue* front;
-extern queue* rear;
-extern priorityqueue* priorityfront;
-extern priorityqueue* priorityrear;
 
 // ----------------------------
 // Core API used by GUI
@@ -67,18 +62,124 @@ int updateFillLevel(int id, int newFillLevel);
 Dustbin* findBinByID(int id);
 void freeLinkedList();
 
+// Bin positions. addBin places a bin on its area's bearing at its own
+// depot distance, up to 0.5 km to either side (area_table.h); addBinAt and
+// moveBin take a position from a real survey or GPS fix instead.
+int addBinAt(int id, char* area, float distance, int fillLevel, float x, float y);
+int moveBin(int id, float x, float y);
+
+// Nearby-bin queries over a grid index of bin positions. filter (may be
+// NULL) returns nonzero for bins to keep. findBinsWithinRadius returns the
+// number of matches and writes the first max; findNearestBins writes up to
+// k bins within maxKm (0: any distance) nearest first, with their
+// distances in distKm (may be NULL).
+typedef int (*BinFilter)(const Dustbin* bin, void* userData);
+int findBinsWithinRadius(float x, float y, float radiusKm, BinFilter filter, void* userData,
+                         Dustbin** out, int max);
+int findNearestBins(float x, float y, int k, float maxKm, BinFilter filter, void* userData,
+                    Dustbin** out, float* distKm);
+
 // Queue / priority queue and sorting
 void classify(Dustbin* node);
 void enqueue(Dustbin* node);
 void deletefromqueue(int id);
 void priorityenqueue(Dustbin* dustnode);
 void deletefrompriorityqueue(int id);
+Dustbin* priorityPeek(void);
+int priorityQueueSize(void);
+int priorityQueueSnapshot(Dustbin** out, int max);
+Dustbin* queueFront(void);
+Dustbin* queueNextByDistance(const Dustbin* bin);
+int queueSize(void);
+int binInPriorityQueue(const Dustbin* bin);
+int binInNormalQueue(const Dustbin* bin);
+Dustbin* queueBinAt(int index);             // index-th bin of the normal queue, nearest first
+int queueIndexOf(const Dustbin* bin);       // position it has (or had) in the normal queue
+int binCount(void);
+Dustbin* binAt(int index);                  // bins in store order, O(1)
 void display();
 void prioritydisplay();
 void queueBinsByDistance();
 void clearQueue();
 void clearPriorityQueue();
 
+// Change notifications. Listeners run synchronously after the core has
+// finished the change, so queue membership and fill are already current.
+// Single-bin operations move at most one bin between queues per
+// notification (views can track row positions from that). A batch from
+// applyFillUpdates is announced once per distinct bin after the whole batch
+// is in place, so queue sizes may already have moved by several bins when
+// its first notification arrives. BIN_REMOVED fires while the bin is still
+// readable, with storeSlot holding the slot it vacated. BIN_RESET (bin is
+// NULL) means a queue or the fleet was cleared, or a batch touched so much
+// of it that views should resync from scratch.
+typedef enum BinChange {
+    BIN_ADDED,
+    BIN_UPDATED,
+    BIN_REMOVED,
+    BIN_RESET
+} BinChange;
+
+typedef void (*BinChangeListener)(BinChange change, const Dustbin* bin, void* userData);
+
+int addBinChangeListener(BinChangeListener listener, void* userData);
+void removeBinChangeListener(BinChangeListener listener, void* userData);
+
+// Batched sensor readings
+typedef struct FillUpdate {
+    int binID;
+    int fillLevel;
+} FillUpdate;
+
+// A bin that crossed the 90% urgency line during a batch
+typedef struct FillTransition {
+    int binID;
+    int nowUrgent;  // 1: became urgent, 0: no longer urgent
+} FillTransition;
+
+// Applies every reading, then fixes queue membership once. Unknown IDs and
+// out-of-range levels are skipped. Returns the number of transitions; only
+// the first maxTransitions are written to transitions (which may be NULL
+// when maxTransitions is 0).
+size_t applyFillUpdates(const FillUpdate* updates, size_t count,
+                        FillTransition* transitions, size_t maxTransitions);
+
+// Fleet-wide fill statistics, kept current as bins change (O(1) to read)
+typedef struct FillSummary {
+    int total;
+    int urgent;     // >= 90%
+    int high;       // 70-89%
+    int medium;     // 50-69%
+    int low;        // < 50%
+    int nonEmpty;
+} FillSummary;
+
+void getFillSummary(FillSummary* out);
+
+// Recounts the categories from the bin store's fill column in one SIMD pass
+// and compares them with the counters above. For tests and debugging;
+// returns 0 (and logs both) if they disagree.
+int verifyFillCounters(void);
+
+// Finer views of the same data, also maintained incrementally
+#define FILL_BUCKETS 10     // 0-9%, 10-19%, ..., 90-100%
+void getFillHistogram(int buckets[FILL_BUCKETS]);
+
+typedef struct AreaFillStats {
+    const char* area;
+    int bins;
+    int urgent;
+    float averageFill;
+} AreaFillStats;
+
+// Areas that currently hold bins, in area order; returns how many were
+// written (at most max)
+int getAreaFillStats(AreaFillStats* out, int max);
+
+// Changes whenever any of the statistics above may have changed, so
+// readers can skip recomputing anything derived from them
+unsigned long getFleetVersion(void);
+
 // Simulation / system helpers
 void initializeRandomBins();
 void collectBinsFromArea(char* area);
@@ -87,19 +188,45 @@ void simulateFillLevelIncrease();
 void displaySystemStatus();
 void freeAreaDistances();
 
+void markBinCollectedAndRequeue(int binID);
+
+// One truck's trip in a dispatch (fleet.h). A truck calls at no more than
+// MAX_DISPATCH_STOPS areas per trip.
+#define MAX_DISPATCH_STOPS 32
+
 typedef struct DispatchSummary {
     int  valid;
-    int  targetID;
-    char area[50];
+    int  truckID;
+    int  targetID;          // most pressing bin the truck emptied
+    char area[50];          // and its area
     float distance;
     int  startFill;
-    int  binsCollected;
-    float totalTimeMinutes;
+    int  binsCollected;     // over the whole route
+    float totalTimeMinutes; // driving plus loading, depot to depot
     int  wasPriority;
+    int  stopCount;         // areas visited, in route order
+    char stops[MAX_DISPATCH_STOPS][50];
+    int  stopBins[MAX_DISPATCH_STOPS];  // bins emptied at each stop
+    int  nearbyCollected;   // extra bins from other areas picked up near stops
+    float totalKm;
+    float travelMinutes;
+    float loadMinutes;
 } DispatchSummary;
 
+// First truck of the last dispatch, NULL if none went out
 const DispatchSummary* getLastDispatchSummary(void);
 
+// Concurrent access. The core does no locking of its own: a thread that
+// mutates it holds the write lock for the whole operation, and read-only
+// callers (table rendering, summaries) share the read lock, which costs
+// next to nothing when no writer is active. coreTryReadLock returns 1 if
+// the lock was taken.
+void coreReadLock(void);
+int coreTryReadLock(void);
+void coreReadUnlock(void);
+void coreWriteLock(void);
+void coreWriteUnlock(void);
+
 #endif
 
 
@@ -0,0 +1,65 @@
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include <stddef.h>
+#include "area_table.h"
+
+// ----------------------------
+// Area-to-area distance matrix
+// ----------------------------
+// Travel km between every pair of interned areas, held as the strict lower
+// triangle of a symmetric matrix (row a stores the pairs (a, 0 .. a-1)) in
+// one 64-byte aligned float array, so a lookup is one index computation and
+// one load. Legs to and from a depot still come from area_table.h.
+//
+// Pairs come from a distance file when one is loaded, and otherwise from
+// the planar estimate in areaTravelKm. The matrix is rebuilt lazily after
+// areas are added or moved; a file survives that, and is re-resolved by
+// area name, so it still applies after the fleet is reinitialized.
+//
+// Files are either CSV ("from,to,km" per line, '#' starts a comment) or
+// the binary form written by distanceMatrixSave: a 64-byte header, the area
+// names as 50-byte records, then the triangle at a 64-byte boundary, in
+// host byte order. A binary file is mapped rather than read, and used in
+// place when its areas have the same ids as the running table.
+
+typedef struct DistanceMatrix {
+    int areas;              // covers area ids 0 .. areas-1
+    const float* cells;     // areas * (areas - 1) / 2 entries
+} DistanceMatrix;
+
+// Beyond this many areas (8.4M cells, 32 MB) later ids use areaTravelKm
+#define DISTANCE_MATRIX_MAX_AREAS 4096
+
+static inline size_t distanceMatrixIndex(int a, int b) {
+    return (size_t)a * (size_t)(a - 1) / 2 + (size_t)b;   // requires a > b
+}
+
+// Both ids must be below m->areas
+static inline float distanceMatrixAt(const DistanceMatrix* m, int a, int b) {
+    if (a == b) return 0.0f;
+    return a > b ? m->cells[distanceMatrixIndex(a, b)] : m->cells[distanceMatrixIndex(b, a)];
+}
+
+// Up to date with the area table; NULL if there are no areas or the
+// matrix could not be allocated
+const DistanceMatrix* distanceMatrixCurrent(void);
+
+// The matrix entry when both areas are covered, areaTravelKm otherwise.
+// Loops fetch the matrix once and use the inline form.
+static inline float distanceMatrixLegKm(const DistanceMatrix* m, int a, int b) {
+    if (m && a >= 0 && b >= 0 && a < m->areas && b < m->areas) return distanceMatrixAt(m, a, b);
+    return areaTravelKm(a, b);
+}
+float distanceMatrixKm(int a, int b);
+
+// Each returns 1 on success and keeps the previous source on failure
+int distanceMatrixOpen(const char* path);     // binary or CSV, by content
+int distanceMatrixLoadCsv(const char* path);
+int distanceMatrixMap(const char* path);
+int distanceMatrixSave(const char* path);     // current matrix, binary form
+
+// Drops any loaded file and the matrix itself
+void distanceMatrixFree(void);
+
+#endif
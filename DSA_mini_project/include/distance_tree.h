@@ -0,0 +1,28 @@
+#ifndef DISTANCE_TREE_H
+#define DISTANCE_TREE_H
+
+struct Dustbin;
+
+// ----------------------------
+// Distance-ordered bin index
+// ----------------------------
+// Intrusive red-black tree over Dustbin nodes, ordered by (distance, binID).
+// The link fields live in Dustbin itself, so insert/remove never allocate
+// and the tree stays balanced whatever order distances arrive in.
+// Nodes also carry their subtree size, so the k-th bin and a bin's position
+// are O(log n) as well.
+
+typedef struct DistanceTree {
+    struct Dustbin* root;
+    struct Dustbin* first;   // nearest bin, cached for O(1) front access
+    int count;
+} DistanceTree;
+
+void distanceTreeInsert(DistanceTree* tree, struct Dustbin* bin);
+void distanceTreeRemove(DistanceTree* tree, struct Dustbin* bin);
+struct Dustbin* distanceTreeNext(const struct Dustbin* bin);
+void distanceTreeClear(DistanceTree* tree);
+struct Dustbin* distanceTreeSelect(const DistanceTree* tree, int index);
+int distanceTreeRank(const DistanceTree* tree, const struct Dustbin* bin);
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef FLEET_H
+#define FLEET_H
+
+#include "core.h"
+
+// ----------------------------
+// Truck fleet and dispatcher
+// ----------------------------
+// The trucks a dispatch can send out, each with its own capacity, speed,
+// shift and depot. dispatchFleet hands bins to trucks in service order
+// (urgent bins as the priority queue would pop them, then the normal queue
+// nearest first), keeping every truck within its capacity and shift, plans
+// one tour per truck over the areas it was given, drives them and records
+// a DispatchSummary per truck that went out. At each stop a truck with
+// room to spare also empties nearby well-filled bins of other areas found
+// through the spatial index.
+//
+// Assignment is linear in the bins considered plus one pass over the
+// trucks per stop opened, and tour improvement shares a fixed time budget,
+// so planning stays bounded for hundreds of trucks and 100k bins.
+
+typedef struct Truck {
+    int   id;
+    float capacity;         // full-bin loads per trip (a 50% bin is half a load)
+    float speedKmph;
+    float shiftMinutes;     // longest trip, depot to depot, loading included
+    float loadMinutes;      // per bin emptied
+    float depotX, depotY;   // km from the main depot (areaKmFromPoint)
+} Truck;
+
+// What simulateTruckCollection sends out when no fleet was configured
+#define DEFAULT_FLEET_TRUCKS 3
+#define DEFAULT_TRUCK_CAPACITY 4.0f
+#define DEFAULT_TRUCK_SPEED_KMPH 30.0f
+#define DEFAULT_TRUCK_SHIFT_MINUTES 480.0f
+#define DEFAULT_TRUCK_LOAD_MINUTES 3.0f
+
+int fleetAddTruck(const Truck* truck);     // index of the new truck, -1 on failure
+int fleetSize(void);
+const Truck* fleetTruck(int index);
+void fleetAddDefaultTrucks(void);
+void fleetClear(void);
+
+// A planned trip, before anything is collected: stops in tour order, the
+// legs between them and the bins to empty at each stop
+typedef struct TruckTrip {
+    int   truck;                            // fleet index
+    int   stopCount;
+    int   stopArea[MAX_DISPATCH_STOPS];
+    float legKm[MAX_DISPATCH_STOPS + 1];    // into each stop, then back to the depot
+    int   firstBin[MAX_DISPATCH_STOPS + 1]; // stop s empties bins[firstBin[s]] up to bins[firstBin[s + 1]]
+    int   leadBin;                          // most pressing bin, as an index into bins
+    float km;
+    int   fill;                             // fill points on board at the end of the trip
+    float minutesLeft;                      // time limit the trip was planned against
+} TruckTrip;
+
+typedef struct FleetPlan {
+    TruckTrip* trips;
+    int tripCount;
+    Dustbin** bins;
+    char* binTaken;     // by storeSlot: on one of the trips; NULL if nothing was planned
+} FleetPlan;
+
+// Narrows what planFleetTrips may hand out; a NULL member lifts that limit
+typedef struct FleetPlanOptions {
+    const unsigned char* available;     // per truck: nonzero if it may go out
+    const float* minutesLeft;           // per truck: replaces its shiftMinutes
+    BinFilter accept;                   // bins worth a trip
+    void* userData;
+} FleetPlanOptions;
+
+// Assigns bins and plans tours exactly as dispatchFleet does, but collects
+// nothing, so the caller decides when each trip happens (simulator.h).
+// options may be NULL. The plan stays valid until the next plan or
+// dispatch, as long as no bin is deleted. Returns the number of trips.
+int planFleetTrips(long budgetMicros, const FleetPlanOptions* options, FleetPlan* out);
+
+// Plans and drives one round of the whole fleet; tour improvement across
+// all trucks stops after about budgetMicros. Returns the number of trucks
+// that went out.
+int dispatchFleet(long budgetMicros);
+
+// Per-truck results of the last dispatch, in fleet order
+int getDispatchSummaryCount(void);
+const DispatchSummary* getDispatchSummary(int index);
+
+#endif
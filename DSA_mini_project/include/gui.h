@@ -10,19 +10,65 @@ extern GtkWidget *priority_table;
 extern GtkWidget *normal_table;
 extern GtkWidget *status_label;
 extern GtkWidget *analytics_area;
+extern GtkWidget *analytics_info_label;
+extern GtkWidget *main_window;
+extern gboolean dark_mode_enabled;
 
 // Main GTK initialization
 void start_gui(int *argc, char ***argv);
 
+// The All Bins table (sets bin_table) inside its scrolled window
+GtkWidget* create_bins_table();
+
 // Functions to refresh GUI components
 void refresh_bin_table();
 void refresh_priority_queue();
 void refresh_normal_queue();
 void refresh_system_status();
 void refresh_analytics();
+
+// What the analytics chart plots (gui_analytics.c)
+typedef enum AnalyticsView {
+    ANALYTICS_CATEGORIES,       // urgent / high / medium / low
+    ANALYTICS_FILL_BUCKETS,     // 10% fill bands
+    ANALYTICS_AREAS,            // bins per area, coloured by average fill
+    ANALYTICS_HISTORY           // totals after each fleet change
+} AnalyticsView;
+void set_analytics_view(AnalyticsView view);
 void trigger_truck_animation();
 void append_event_log(const char *message);
 
+// Event log: keeps the newest max_lines lines on screen and, if
+// mirror_path is set, appends every line to that file. The file rotates
+// to mirror_path.1, .2, ... once it reaches max_file_bytes (0: never),
+// keeping max_files files in all.
+#define EVENT_LOG_DEFAULT_LINES 500
+void configure_event_log(int max_lines, const char *mirror_path, long max_file_bytes, int max_files);
+void flush_event_log(void);
+
+// Views the refresh scheduler keeps current; OR them together
+#define VIEW_BIN_TABLE      (1u << 0)
+#define VIEW_PRIORITY_QUEUE (1u << 1)
+#define VIEW_NORMAL_QUEUE   (1u << 2)
+#define VIEW_SYSTEM_STATUS  (1u << 3)
+#define VIEW_ANALYTICS      (1u << 4)
+#define VIEW_EVENT_LOG      (1u << 5)
+#define VIEW_ALL            0x3fu
+
+// Mark views stale. Core changes do this on their own; every stale view is
+// brought up to date together, at most once per frame.
+void schedule_refresh(guint views);
+// Blank the live tables until the next refresh (a worker owns the core)
+void freeze_live_views(void);
+
+// Long core operations run on a worker thread holding the core write lock;
+// done runs afterwards on the main loop. Returns FALSE if a job is already
+// running, in which case nothing was started.
+typedef void (*CoreJobFunc)(gpointer data);
+typedef void (*CoreJobDone)(gpointer data);
+gboolean run_core_job(CoreJobFunc func, CoreJobDone done, gpointer data);
+gboolean core_job_running(void);
+
 // Callback prototypes used across GUI files
 void on_bin_row_activated(GtkTreeView *tree_view,
                           GtkTreePath *path,
@@ -35,5 +81,8 @@ void on_init_random_clicked(GtkButton *button, gpointer user_data);
 void on_fill_time_clicked(GtkButton *button, gpointer user_data);
 void on_sort_bins_clicked(GtkButton *button, gpointer user_data);
 void on_truck_collect_clicked(GtkButton *button, gpointer user_data);
+gboolean on_analytics_draw(GtkWidget *widget, cairo_t *cr, gpointer data);
+gboolean on_analytics_button_press(GtkWidget *widget, GdkEventButton *event, gpointer data);
+void on_analytics_view_changed(GtkComboBox *combo, gpointer data);
 
 #endif
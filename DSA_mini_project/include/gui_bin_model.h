@@ -0,0 +1,51 @@
+#ifndef GUI_BIN_MODEL_H
+#define GUI_BIN_MODEL_H
+
+#include <gtk/gtk.h>
+#include "core.h"
+
+// ----------------------------
+// Virtual tree model over the core
+// ----------------------------
+// A flat GtkTreeModel whose rows are bins read straight from the core on
+// demand; nothing is copied and cell text is only formatted for the rows a
+// view asks about. Rows are addressed by position:
+//   BIN_MODEL_ALL      - every bin, in bin store order (binAt)
+//   BIN_MODEL_PRIORITY - urgent bins in dispatch order (cached snapshot)
+//   BIN_MODEL_NORMAL   - normal queue, nearest first (queueBinAt)
+// Columns are the five strings the tables show: ID, area, distance, fill
+// and status.
+
+typedef enum BinModelKind {
+    BIN_MODEL_ALL,
+    BIN_MODEL_PRIORITY,
+    BIN_MODEL_NORMAL
+} BinModelKind;
+
+enum {
+    BIN_COL_ID,
+    BIN_COL_AREA,
+    BIN_COL_DISTANCE,
+    BIN_COL_FILL,
+    BIN_COL_STATUS,
+    BIN_N_COLUMNS
+};
+
+#define BIN_TYPE_TREE_MODEL (bin_tree_model_get_type())
+G_DECLARE_FINAL_TYPE(BinTreeModel, bin_tree_model, BIN, TREE_MODEL, GObject)
+
+BinTreeModel* bin_tree_model_new(BinModelKind kind);
+
+// Translate one core change notification into row signals. Returns TRUE
+// when the change couldn't be followed row by row; the rows are then
+// recounted on the spot (deleted or appended at the end, so every row still
+// has a bin) and the view wants a bin_tree_model_resync() with no view
+// attached to redraw them in order.
+gboolean bin_tree_model_apply_change(BinTreeModel *model, BinChange change, const Dustbin *bin);
+gboolean bin_tree_model_needs_resync(BinTreeModel *model);
+// Drop every row without telling anyone, until the next resync; used while
+// another thread owns the core. Detach the model from its view first.
+void bin_tree_model_invalidate(BinTreeModel *model);
+void bin_tree_model_resync(BinTreeModel *model);
+
+#endif
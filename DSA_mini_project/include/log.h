@@ -0,0 +1,72 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdio.h>
+
+// ----------------------------
+// Leveled, buffered logging
+// ----------------------------
+// Messages are formatted straight into a lock-free ring buffer and written
+// out by a background thread, so callers never wait on terminal or file I/O.
+// When the ring is full a message is dropped (and counted) rather than
+// blocking the caller.
+//
+// SMARTWASTE_LOG_MIN_LEVEL removes every call below it at compile time;
+// logSetLevel() filters further at run time.
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO  1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF   4
+
+#ifndef SMARTWASTE_LOG_MIN_LEVEL
+#define SMARTWASTE_LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_MESSAGE_MAX 256     // longer messages are truncated
+#define LOG_RING_SIZE   4096    // slots, power of two
+
+void logWrite(int level, const char* format, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    ;
+
+void logSetLevel(int level);            // runtime minimum, default LOG_LEVEL_INFO
+int logLevelEnabled(int level);
+void logSetOutput(FILE* out);           // default stdout; NULL restores it
+void logSetSynchronous(int enabled);    // write on the caller's thread (interactive use)
+void logFlush(void);                    // wait until everything queued so far is written
+unsigned long logDroppedCount(void);
+void logShutdown(void);                 // flush and stop the writer (also run at exit)
+
+// True only if the level survives both the compile-time and runtime filters;
+// use it to skip building expensive output altogether
+#define LOG_ENABLED(level) ((level) >= SMARTWASTE_LOG_MIN_LEVEL && logLevelEnabled(level))
+
+#if SMARTWASTE_LOG_MIN_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) logWrite(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if SMARTWASTE_LOG_MIN_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) logWrite(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if SMARTWASTE_LOG_MIN_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) logWrite(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if SMARTWASTE_LOG_MIN_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) logWrite(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include <stddef.h>
+
+// ----------------------------
+// Core allocation layer
+// ----------------------------
+// All core heap traffic goes through these wrappers so it can be counted.
+// Fixed-size nodes come from pools with free lists; short-lived scratch
+// buffers come from an arena that is rewound in one step.
+
+typedef struct AllocStats {
+    unsigned long mallocs;      // malloc/calloc calls that reached the C heap
+    unsigned long reallocs;
+    unsigned long frees;
+    unsigned long poolAllocs;   // objects handed out by pools
+    unsigned long poolFrees;
+    unsigned long arenaAllocs;  // scratch buffers handed out by arenas
+} AllocStats;
+
+void* coreMalloc(size_t size);
+void* coreCalloc(size_t count, size_t size);
+void* coreRealloc(void* ptr, size_t size);
+void coreFree(void* ptr);
+const AllocStats* getAllocStats(void);
+void resetAllocStats(void);
+
+// Fixed-size object pool: slabs of objects threaded on a free list
+typedef struct PoolSlab PoolSlab;
+
+typedef struct Pool {
+    size_t objectSize;
+    size_t perSlab;
+    void* freeList;
+    PoolSlab* slabs;
+    size_t inUse;
+} Pool;
+
+void poolInit(Pool* pool, size_t objectSize, size_t perSlab);
+void* poolAlloc(Pool* pool);
+void poolFree(Pool* pool, void* object);
+void poolReset(Pool* pool);       // every object back on the free list, slabs kept
+void poolDestroy(Pool* pool);
+
+// Bump allocator for transient data; arenaReset rewinds without freeing
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    size_t blockSize;
+} Arena;
+
+void arenaInit(Arena* arena, size_t blockSize);
+void* arenaAlloc(Arena* arena, size_t size);
+void arenaReset(Arena* arena);
+void arenaFree(Arena* arena);
+
+#endif
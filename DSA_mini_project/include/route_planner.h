@@ -0,0 +1,31 @@
+#ifndef ROUTE_PLANNER_H
+#define ROUTE_PLANNER_H
+
+// ----------------------------
+// Multi-stop route planning
+// ----------------------------
+// Orders a set of areas into one depot -> stops -> depot tour using leg
+// lengths from the area distance matrix (distance_matrix.h). A
+// nearest-neighbour tour is built first and then improved with 2-opt
+// (reverse a stretch of the tour) and Or-opt (move a run of 1-3 stops
+// elsewhere, either way round) until no move shortens it or the time
+// budget runs out, whichever comes first.
+
+typedef struct RouteResult {
+    double km;              // final tour length, depot to depot
+    double initialKm;       // nearest-neighbour tour before improvement
+    int improvements;       // 2-opt / Or-opt moves applied
+    int timedOut;           // 1 if the budget ended the search early
+} RouteResult;
+
+// Writes the count area ids of areaIds to order, in visiting order. A
+// budget of 0 or less returns the constructed tour unimproved. result may
+// be NULL. Returns 0 if scratch memory could not be allocated.
+int planRoute(const int* areaIds, int count, long budgetMicros, int* order, RouteResult* result);
+
+// The same for a truck based somewhere other than the main depot; the
+// depot is given in areaKmFromPoint coordinates
+int planRouteFrom(float depotX, float depotY, const int* areaIds, int count,
+                  long budgetMicros, int* order, RouteResult* result);
+
+#endif
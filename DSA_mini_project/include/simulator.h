@@ -0,0 +1,60 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+// ----------------------------
+// Discrete-event simulation
+// ----------------------------
+// Runs the current bins and fleet (fleet.h) through days of operation on a
+// simulated clock, as fast as the events can be processed. Events are kept
+// in one queue ordered by time:
+//   fill tick    - a bin's sensor reports; its fill grows at the bin's own
+//                  rate since the last report
+//   dispatch     - during shifts, idle trucks are planned trips over the
+//                  bins worth collecting that no truck is already heading to
+//   departure    - a truck leaves its depot
+//   arrival      - a truck reaches a stop and empties the bins it came
+//                  for, plus any others there past topUpThreshold that it
+//                  has room and shift time for, or is back at the depot
+//   unload       - a returned truck has tipped its load and is free again
+// Fill and collection go through the core, so queues and statistics stay
+// current for anything watching. Bins must not be added or deleted while
+// a simulation runs.
+
+typedef struct SimConfig {
+    int   days;
+    unsigned int seed;              // for the per-bin fill rates
+    float tickMinutes;              // sensor report interval per bin
+    float minFillPerHour;           // fill rates, in % per hour, are drawn
+    float maxFillPerHour;           // uniformly from this range per bin
+    float shiftStartMinutes;        // after midnight; shifts last shiftMinutes per truck
+    float dispatchMinutes;          // how often idle trucks are reconsidered in a shift
+    float unloadMinutes;            // at the depot after every trip
+    int   collectThreshold;         // fill % a bin needs before it is worth a trip
+    int   topUpThreshold;           // fill % at which a truck already at a stop empties
+                                    // other bins of the area too, 0 for none
+    long  planBudgetMicros;         // tour improvement budget per dispatch
+} SimConfig;
+
+typedef struct SimKpis {
+    double simulatedMinutes;
+    unsigned long events;
+    unsigned long fillTicks;
+    unsigned long departures;
+    unsigned long arrivals;         // stops and depot returns
+    unsigned long unloads;
+    unsigned long lateReturns;      // trips back at the depot after the shift ended
+    double overflowMinutes;         // bin-minutes spent at 100%
+    long   overflows;               // times a bin reached 100%
+    double kmDriven;
+    long   binsCollected;
+    double wallSeconds;
+    double eventsPerSecond;
+} SimKpis;
+
+void simConfigDefaults(SimConfig* config);
+
+// Adds the default trucks if the fleet is empty. Returns 0 if there are no
+// bins or memory ran out.
+int runSimulation(const SimConfig* config, SimKpis* kpis);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <stddef.h>
+
+struct Dustbin;
+
+// ----------------------------
+// Spatial index over bin positions
+// ----------------------------
+// Bins are bucketed by (x, y) into square cells of SPATIAL_CELL_KM; the
+// occupied cells live in an open-addressing table keyed by cell
+// coordinates, and each cell chains its bins through Dustbin.gridNext /
+// gridPrev, so insert, remove and move are O(1) and never allocate per bin.
+// A radius query visits only the cells the circle overlaps, and a
+// k-nearest query searches outward ring by ring until no closer bin can
+// remain, so both cost about the number of bins near the answer rather
+// than the fleet size.
+
+#define SPATIAL_CELL_KM 0.5f
+
+typedef struct SpatialCell {
+    int cx, cy;
+    int occupied;               // slot in use (the cell may be empty now)
+    int count;
+    struct Dustbin* first;
+} SpatialCell;
+
+typedef struct SpatialGrid {
+    SpatialCell* cells;
+    size_t capacity;            // 0 or a power of two
+    size_t used;                // occupied slots
+    int minCx, maxCx, minCy, maxCy;   // extent of every cell ever used
+} SpatialGrid;
+
+// Return nonzero to accept a bin in a query
+typedef int (*SpatialFilter)(const struct Dustbin* bin, void* userData);
+
+int spatialInsert(SpatialGrid* grid, struct Dustbin* bin);     // 0 on allocation failure
+void spatialRemove(SpatialGrid* grid, struct Dustbin* bin);
+int spatialMove(SpatialGrid* grid, struct Dustbin* bin, float x, float y);
+
+// Bins within radiusKm of (x, y), in no particular order. Returns how many
+// matched; only the first max are written.
+int spatialRadius(const SpatialGrid* grid, float x, float y, float radiusKm,
+                  SpatialFilter filter, void* userData, struct Dustbin** out, int max);
+
+// Up to k accepted bins nearest to (x, y) and no more than maxKm away (0:
+// any distance), nearest first; distKm (may be NULL) receives their
+// distances. Returns how many were found. The search stops at maxKm, so a
+// filter that accepts few bins doesn't send it across the whole grid.
+int spatialNearest(const SpatialGrid* grid, float x, float y, int k, float maxKm,
+                   SpatialFilter filter, void* userData, struct Dustbin** out, float* distKm);
+
+void spatialClear(SpatialGrid* grid);
+void spatialFree(SpatialGrid* grid);
+
+#endif
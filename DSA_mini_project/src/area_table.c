@@ -0,0 +1,226 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "area_table.h"
+#include "core.h"
+#include "mempool.h"
+
+typedef struct AreaEntry {
+    char name[50];
+    float distance;
+    float x, y;                   // estimated position, depot at the origin
+    Dustbin* firstBin;
+    int binCount;
+    long fillSum;
+    int urgentCount;
+} AreaEntry;
+
+static AreaEntry* areas = NULL;   // indexed by area id
+static int areaTotal = 0;
+static int areaCapacity = 0;
+
+static unsigned long geometryVersion = 0;
+
+static int* slots = NULL;         // open-addressing table of area ids, -1 = empty
+static int slotCapacity = 0;      // power of two
+
+static uint32_t hashName(const char* name) {
+    uint32_t h = 2166136261u;     // FNV-1a
+    while (*name) {
+        h ^= (unsigned char)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int findSlot(const char* name) {
+    int mask = slotCapacity - 1;
+    int i = (int)(hashName(name) & (uint32_t)mask);
+    while (slots[i] >= 0 && strcmp(areas[slots[i]].name, name) != 0) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static int growSlots(void) {
+    int newCapacity = slotCapacity ? slotCapacity * 2 : 32;
+    int* grown = (int*)coreMalloc(newCapacity * sizeof(int));
+    if (!grown) return 0;
+    for (int i = 0; i < newCapacity; i++) grown[i] = -1;
+    coreFree(slots);
+    slots = grown;
+    slotCapacity = newCapacity;
+    for (int id = 0; id < areaTotal; id++) {
+        slots[findSlot(areas[id].name)] = id;
+    }
+    return 1;
+}
+
+// Names are stored truncated to the same 49 characters as Dustbin.area
+static void truncateName(char* out, const char* name) {
+    strncpy(out, name, 49);
+    out[49] = '\0';
+}
+
+int areaLookup(const char* name) {
+    if (!name || slotCapacity == 0) return -1;
+    char key[50];
+    truncateName(key, name);
+    return slots[findSlot(key)];
+}
+
+int areaIntern(const char* rawName) {
+    if (!rawName) return -1;
+    if ((areaTotal + 1) * 2 > slotCapacity && !growSlots()) return -1;
+
+    char name[50];
+    truncateName(name, rawName);
+
+    int slot = findSlot(name);
+    if (slots[slot] >= 0) return slots[slot];
+
+    if (areaTotal == areaCapacity) {
+        int newCapacity = areaCapacity ? areaCapacity * 2 : 16;
+        AreaEntry* grown = (AreaEntry*)coreRealloc(areas, newCapacity * sizeof(AreaEntry));
+        if (!grown) return -1;
+        areas = grown;
+        areaCapacity = newCapacity;
+    }
+    AreaEntry* entry = &areas[areaTotal];
+    strcpy(entry->name, name);
+    entry->distance = -1.0f;
+    entry->x = entry->y = 0.0f;
+    entry->firstBin = NULL;
+    entry->binCount = 0;
+    entry->fillSum = 0;
+    entry->urgentCount = 0;
+    slots[slot] = areaTotal;
+    geometryVersion++;
+    return areaTotal++;
+}
+
+const char* areaName(int id) {
+    if (id < 0 || id >= areaTotal) return "";
+    return areas[id].name;
+}
+
+int areaCount(void) {
+    return areaTotal;
+}
+
+float areaDistance(int id) {
+    if (id < 0 || id >= areaTotal) return -1.0f;
+    return areas[id].distance;
+}
+
+// Golden-angle bearings keep consecutive ids well apart around the depot
+static float areaBearing(int id) {
+    return (float)id * 2.39996323f;
+}
+
+void areaPointAt(int id, float distance, float offset, float* x, float* y) {
+    float bearing = areaBearing(id);
+    float c = cosf(bearing), s = sinf(bearing);
+    *x = distance * c - offset * s;
+    *y = distance * s + offset * c;
+}
+
+void areaSetDistance(int id, float distance) {
+    if (id < 0 || id >= areaTotal) return;
+    areas[id].distance = distance;
+    areaPointAt(id, distance > 0 ? distance : 0.0f, 0.0f, &areas[id].x, &areas[id].y);
+    geometryVersion++;
+}
+
+void areaResetDistances(void) {
+    for (int id = 0; id < areaTotal; id++) {
+        areas[id].distance = -1.0f;
+        areas[id].x = areas[id].y = 0.0f;
+    }
+    geometryVersion++;
+}
+
+unsigned long areaGeometryVersion(void) {
+    return geometryVersion;
+}
+
+float areaTravelKm(int from, int to) {
+    float fx = 0.0f, fy = 0.0f, tx = 0.0f, ty = 0.0f;
+    if (from >= 0 && from < areaTotal) fx = areas[from].x, fy = areas[from].y;
+    if (to >= 0 && to < areaTotal) tx = areas[to].x, ty = areas[to].y;
+    return sqrtf((tx - fx) * (tx - fx) + (ty - fy) * (ty - fy));
+}
+
+float areaKmFromPoint(float x, float y, int id) {
+    float tx = 0.0f, ty = 0.0f;
+    if (id >= 0 && id < areaTotal) tx = areas[id].x, ty = areas[id].y;
+    return sqrtf((tx - x) * (tx - x) + (ty - y) * (ty - y));
+}
+
+void areaAttachBin(Dustbin* bin) {
+    AreaEntry* area = &areas[bin->areaId];
+    bin->areaPrev = NULL;
+    bin->areaNext = area->firstBin;
+    if (area->firstBin) area->firstBin->areaPrev = bin;
+    area->firstBin = bin;
+    area->binCount++;
+    area->fillSum += bin->fillLevel;
+    area->urgentCount += bin->fillLevel >= 90;
+}
+
+void areaDetachBin(Dustbin* bin) {
+    AreaEntry* area = &areas[bin->areaId];
+    if (bin->areaPrev) bin->areaPrev->areaNext = bin->areaNext;
+    else area->firstBin = bin->areaNext;
+    if (bin->areaNext) bin->areaNext->areaPrev = bin->areaPrev;
+    bin->areaNext = bin->areaPrev = NULL;
+    area->binCount--;
+    area->fillSum -= bin->fillLevel;
+    area->urgentCount -= bin->fillLevel >= 90;
+}
+
+Dustbin* areaFirstBin(int id) {
+    if (id < 0 || id >= areaTotal) return NULL;
+    return areas[id].firstBin;
+}
+
+int areaBinCount(int id) {
+    if (id < 0 || id >= areaTotal) return 0;
+    return areas[id].binCount;
+}
+
+// Forget bucket membership without touching the (already freed) bins
+void areaClearBins(void) {
+    for (int id = 0; id < areaTotal; id++) {
+        areas[id].firstBin = NULL;
+        areas[id].binCount = 0;
+        areas[id].fillSum = 0;
+        areas[id].urgentCount = 0;
+    }
+}
+
+void areaUpdateFill(const Dustbin* bin, int oldFill) {
+    AreaEntry* area = &areas[bin->areaId];
+    area->fillSum += bin->fillLevel - oldFill;
+    area->urgentCount += (bin->fillLevel >= 90) - (oldFill >= 90);
+}
+
+long areaFillSum(int id) {
+    if (id < 0 || id >= areaTotal) return 0;
+    return areas[id].fillSum;
+}
+
+int areaUrgentCount(int id) {
+    if (id < 0 || id >= areaTotal) return 0;
+    return areas[id].urgentCount;
+}
+
+void areaTableFree(void) {
+    coreFree(areas);
+    coreFree(slots);
+    areas = NULL;
+    slots = NULL;
+    areaTotal = areaCapacity = slotCapacity = 0;
+    geometryVersion++;
+}
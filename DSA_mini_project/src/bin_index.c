@@ -0,0 +1,111 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bin_index.h"
+#include "core.h"
+#include "mempool.h"
+
+#define BIN_INDEX_MIN_CAPACITY 16
+
+// Fibonacci hashing spreads sequential IDs (the common case) across the table
+static size_t homeSlot(int id, size_t mask) {
+    uint32_t h = (uint32_t)id * 2654435769u;
+    h ^= h >> 16;
+    return (size_t)h & mask;
+}
+
+// Keep the load factor under 70%
+static int needsGrow(const BinIndex* index, size_t count) {
+    return count * 10 >= index->capacity * 7;
+}
+
+static int rehash(BinIndex* index, size_t newCapacity) {
+    BinIndexSlot* slots = (BinIndexSlot*)coreCalloc(newCapacity, sizeof(BinIndexSlot));
+    if (!slots) return 0;
+
+    size_t mask = newCapacity - 1;
+    for (size_t i = 0; i < index->capacity; i++) {
+        BinIndexSlot* old = &index->slots[i];
+        if (!old->bin) continue;
+        size_t j = homeSlot(old->binID, mask);
+        while (slots[j].bin) j = (j + 1) & mask;
+        slots[j] = *old;
+    }
+    coreFree(index->slots);
+    index->slots = slots;
+    index->capacity = newCapacity;
+    return 1;
+}
+
+int binIndexReserve(BinIndex* index, size_t expected) {
+    size_t capacity = index->capacity ? index->capacity : BIN_INDEX_MIN_CAPACITY;
+    while (expected * 10 >= capacity * 7) capacity <<= 1;
+    if (capacity == index->capacity) return 1;
+    return rehash(index, capacity);
+}
+
+Dustbin* binIndexFind(const BinIndex* index, int id) {
+    if (index->count == 0) return NULL;
+    size_t mask = index->capacity - 1;
+    size_t i = homeSlot(id, mask);
+    while (index->slots[i].bin) {
+        if (index->slots[i].binID == id) return index->slots[i].bin;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+int binIndexInsert(BinIndex* index, Dustbin* bin) {
+    if (index->capacity == 0 || needsGrow(index, index->count + 1)) {
+        if (!binIndexReserve(index, index->count + 1)) return 0;
+    }
+    size_t mask = index->capacity - 1;
+    size_t i = homeSlot(bin->binID, mask);
+    while (index->slots[i].bin) {
+        if (index->slots[i].binID == bin->binID) return 0; // duplicate
+        i = (i + 1) & mask;
+    }
+    index->slots[i].binID = bin->binID;
+    index->slots[i].bin = bin;
+    index->count++;
+    return 1;
+}
+
+int binIndexRemove(BinIndex* index, int id) {
+    if (index->count == 0) return 0;
+    size_t mask = index->capacity - 1;
+    size_t i = homeSlot(id, mask);
+    while (index->slots[i].bin && index->slots[i].binID != id) {
+        i = (i + 1) & mask;
+    }
+    if (!index->slots[i].bin) return 0;
+
+    // Backward shift: pull later entries of the cluster into the hole
+    // whenever the hole lies between their home slot and their position.
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!index->slots[j].bin) break;
+        size_t k = homeSlot(index->slots[j].binID, mask);
+        int movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+        if (movable) {
+            index->slots[i] = index->slots[j];
+            i = j;
+        }
+    }
+    index->slots[i].bin = NULL;
+    index->count--;
+    return 1;
+}
+
+void binIndexClear(BinIndex* index) {
+    if (index->slots) memset(index->slots, 0, index->capacity * sizeof(BinIndexSlot));
+    index->count = 0;
+}
+
+void binIndexFree(BinIndex* index) {
+    coreFree(index->slots);
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bin_store.h"
+#include "core.h"
+#include "mempool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static int growStore(BinStore* store) {
+    int newCapacity = store->capacity ? store->capacity * 2 : 64;
+    unsigned char* fill = (unsigned char*)coreRealloc(store->fill, newCapacity);
+    if (fill) store->fill = fill;
+    Dustbin** owner = (Dustbin**)coreRealloc(store->owner, newCapacity * sizeof(Dustbin*));
+    if (owner) store->owner = owner;
+
+    // An array that did grow is simply larger than needed; capacity only
+    // advances once both succeeded.
+    if (!fill || !owner) return 0;
+    store->capacity = newCapacity;
+    return 1;
+}
+
+int binStoreAdd(BinStore* store, Dustbin* bin) {
+    if (store->count == store->capacity && !growStore(store)) return 0;
+    int slot = store->count++;
+    store->owner[slot] = bin;
+    bin->storeSlot = slot;
+    binStoreSync(store, bin);
+    return 1;
+}
+
+void binStoreRemove(BinStore* store, Dustbin* bin) {
+    int slot = bin->storeSlot;
+    int last = --store->count;
+    if (slot != last) {
+        store->fill[slot] = store->fill[last];
+        store->owner[slot] = store->owner[last];
+        store->owner[slot]->storeSlot = slot;
+    }
+    // bin->storeSlot keeps the slot it vacated, so change listeners can
+    // tell which row the former last bin moved into
+}
+
+// Copy a bin's fill level back into its slot
+void binStoreSync(BinStore* store, const Dustbin* bin) {
+    store->fill[bin->storeSlot] = (unsigned char)bin->fillLevel;
+}
+
+// Counts bins at or above each category threshold plus empty bins in a
+// single pass. Byte compares are done 32 (AVX2) or 16 (SSE2) at a time into
+// 8-bit lane counters, which are folded into totals before they can wrap.
+void binStoreScanFill(const BinStore* store, FillScan* out) {
+    const unsigned char* fill = store->fill;
+    int n = store->count;
+    int i = 0;
+    long c50 = 0, c70 = 0, c90 = 0, c0 = 0;
+
+#if defined(__AVX2__)
+    const __m256i t50 = _mm256_set1_epi8((char)50);
+    const __m256i t70 = _mm256_set1_epi8((char)70);
+    const __m256i t90 = _mm256_set1_epi8((char)90);
+    const __m256i zero = _mm256_setzero_si256();
+    while (i + 32 <= n) {
+        __m256i a50 = zero, a70 = zero, a90 = zero, a0 = zero;
+        int blocks = (n - i) / 32;
+        if (blocks > 255) blocks = 255;
+        for (int b = 0; b < blocks; b++, i += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(fill + i));
+            // v >= t  <=>  max(v, t) == v; a true lane is 0xFF, i.e. -1
+            a50 = _mm256_sub_epi8(a50, _mm256_cmpeq_epi8(_mm256_max_epu8(v, t50), v));
+            a70 = _mm256_sub_epi8(a70, _mm256_cmpeq_epi8(_mm256_max_epu8(v, t70), v));
+            a90 = _mm256_sub_epi8(a90, _mm256_cmpeq_epi8(_mm256_max_epu8(v, t90), v));
+            a0  = _mm256_sub_epi8(a0,  _mm256_cmpeq_epi8(v, zero));
+        }
+        __m256i sums[4] = { _mm256_sad_epu8(a50, zero), _mm256_sad_epu8(a70, zero),
+                            _mm256_sad_epu8(a90, zero), _mm256_sad_epu8(a0, zero) };
+        long* totals[4] = { &c50, &c70, &c90, &c0 };
+        for (int k = 0; k < 4; k++) {
+            *totals[k] += _mm256_extract_epi64(sums[k], 0) + _mm256_extract_epi64(sums[k], 1)
+                        + _mm256_extract_epi64(sums[k], 2) + _mm256_extract_epi64(sums[k], 3);
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128i t50 = _mm_set1_epi8((char)50);
+    const __m128i t70 = _mm_set1_epi8((char)70);
+    const __m128i t90 = _mm_set1_epi8((char)90);
+    const __m128i zero = _mm_setzero_si128();
+    while (i + 16 <= n) {
+        __m128i a50 = zero, a70 = zero, a90 = zero, a0 = zero;
+        int blocks = (n - i) / 16;
+        if (blocks > 255) blocks = 255;
+        for (int b = 0; b < blocks; b++, i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(fill + i));
+            a50 = _mm_sub_epi8(a50, _mm_cmpeq_epi8(_mm_max_epu8(v, t50), v));
+            a70 = _mm_sub_epi8(a70, _mm_cmpeq_epi8(_mm_max_epu8(v, t70), v));
+            a90 = _mm_sub_epi8(a90, _mm_cmpeq_epi8(_mm_max_epu8(v, t90), v));
+            a0  = _mm_sub_epi8(a0,  _mm_cmpeq_epi8(v, zero));
+        }
+        __m128i sums[4] = { _mm_sad_epu8(a50, zero), _mm_sad_epu8(a70, zero),
+                            _mm_sad_epu8(a90, zero), _mm_sad_epu8(a0, zero) };
+        long* totals[4] = { &c50, &c70, &c90, &c0 };
+        for (int k = 0; k < 4; k++) {
+            *totals[k] += _mm_cvtsi128_si32(sums[k]) + _mm_cvtsi128_si32(_mm_srli_si128(sums[k], 8));
+        }
+    }
+#endif
+
+    // Scalar tail (and the whole scan on targets without SSE2)
+    for (; i < n; i++) {
+        unsigned char v = fill[i];
+        c50 += v >= 50;
+        c70 += v >= 70;
+        c90 += v >= 90;
+        c0 += v == 0;
+    }
+
+    out->total = n;
+    out->atLeast50 = (int)c50;
+    out->atLeast70 = (int)c70;
+    out->atLeast90 = (int)c90;
+    out->empty = (int)c0;
+}
+
+void binStoreClear(BinStore* store) {
+    store->count = 0;
+}
+
+void binStoreFree(BinStore* store) {
+    coreFree(store->fill);
+    coreFree(store->owner);
+    memset(store, 0, sizeof(*store));
+}
@@ -0,0 +1,188 @@
+// Menu-driven console front end. Links only the core library, so it runs
+// on machines without GTK or a display.
+// Optional: --distance-matrix=PATH loads area-to-area distances (CSV or
+// binary, see distance_matrix.h). --simulate=DAYS runs the random bins
+// through DAYS of simulated operation (simulator.h) without the menu,
+// prints the KPIs and exits.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "core.h"
+#include "distance_matrix.h"
+#include "fleet.h"
+#include "simulator.h"
+#include "log.h"
+
+static int runHeadless(int days) {
+    SimConfig config;
+    simConfigDefaults(&config);
+    config.days = days;
+    config.seed = (unsigned int)time(NULL);
+    SimKpis kpis;
+    int ok = runSimulation(&config, &kpis);
+    printf("\n=== SIMULATION KPIs (%d days, %d bins, %d trucks) ===\n", days, binCount(), fleetSize());
+    printf("Events processed:    %lu (%.0f per second)\n", kpis.events, kpis.eventsPerSecond);
+    printf("Trips:               %lu (%lu back after the shift)\n", kpis.departures, kpis.lateReturns);
+    printf("Bins collected:      %ld\n", kpis.binsCollected);
+    printf("Distance driven:     %.1f km\n", kpis.kmDriven);
+    printf("Overflows:           %ld\n", kpis.overflows);
+    printf("Overflow time:       %.0f bin-minutes\n", kpis.overflowMinutes);
+    printf("Wall time:           %.2f s\n", kpis.wallSeconds);
+    fleetClear();
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+    freeAreaDistances();
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    srand(time(NULL));
+    // Interactive: keep core output in step with the prompts, and show the
+    // full queue listings that are debug-level for the GUI
+    logSetSynchronous(1);
+    logSetLevel(LOG_LEVEL_DEBUG);
+    int simulateDays = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--distance-matrix=", 18) == 0) distanceMatrixOpen(argv[i] + 18);
+        if (strncmp(argv[i], "--simulate=", 11) == 0) simulateDays = atoi(argv[i] + 11);
+    }
+    int choice, id, fillLevel;
+    char area[50];
+    float distance;
+
+    printf("====================================================\n");
+    printf("SMART WASTE MANAGEMENT SYSTEM.\n");
+    printf("====================================================\n");
+
+    initializeRandomBins();
+    if (simulateDays > 0) {
+        logSetLevel(LOG_LEVEL_INFO);
+        return runHeadless(simulateDays);
+    }
+
+    while (1) {
+        printf("\n=== MENU ===\n");
+        printf("1. Add New Bin\n");
+        printf("2. Delete Bin\n");
+        printf("3. Update Fill Level\n");
+        printf("4. Display All Bins\n");
+        printf("5. Find Bin by ID\n");
+        printf("6. Reinitialize Random Bins\n");
+        printf("7. Display the order of bins\n");
+        printf("8. Sort and enqueue bins by distance\n");
+        printf("9. Simulate Truck Collection (AUTO) \n");
+        printf("10. Simulate Time Passage (Bins Fill Up)\n");
+        printf("11. Display System Status \n");
+        printf("12. Reinitialize System\n");
+        printf("13. Exit..\n");
+        printf("Enter your choice: ");
+        if (scanf("%d", &choice) != 1) {
+            // End of input (or a non-number) when driven from a pipe
+            choice = 13;
+        }
+        printf("--------------------------------------------------------\n\n");
+
+        switch (choice) {
+            case 1:
+                printf("Enter Bin ID: ");
+                scanf("%d", &id);
+                getchar(); // consume newline
+                printf("Enter Area: ");
+                fgets(area, sizeof(area), stdin);
+                area[strcspn(area, "\n")] = '\0';
+                printf("Enter Distance from Collection Center: ");
+                scanf("%f", &distance);
+                printf("Enter Fill Level (0-100): ");
+                scanf("%d", &fillLevel);
+                addBin(id, area, distance, fillLevel);
+                printf("Bin %d added successfully!\n", id);
+
+                break;
+
+            case 2:
+                printf("Enter Bin ID to delete: ");
+                scanf("%d", &id);
+                deleteBin(id);
+                break;
+
+            case 3:
+                printf("Enter Bin ID: ");
+                scanf("%d", &id);
+                printf("Enter new Fill Level (0-100): ");
+                scanf("%d", &fillLevel);
+                updateFillLevel(id, fillLevel);
+                break;
+
+            case 4:
+                displayBins();
+                break;
+
+            case 5:
+                printf("Enter Bin ID to find: ");
+                scanf("%d", &id);
+                Dustbin* found = findBinByID(id);
+                if (found)
+                    printf("Bin Found: ID=%d, Area=%s, Distance=%.2f, Fill Level=%d%%\n", found->binID, found->area, found->distance, found->fillLevel);
+                else
+                    printf("Bin %d not found!\n", id);
+                break;
+
+            case 6:
+                clearQueue();
+                clearPriorityQueue();
+                freeLinkedList();
+                freeAreaDistances();  // Add this line
+                initializeRandomBins();
+                break;
+
+
+            case 7:
+                printf("Priority Bins: \n");
+                prioritydisplay();
+                printf("Normal Bins: \n");
+                display();
+                break;
+
+            case 8:
+                printf("\nPriority Bins (Urgent) By Distance:\n");
+                queueBinsByDistance();
+                break;
+
+            case 9:
+                simulateTruckCollection();
+                break;
+
+            case 10:
+                simulateFillLevelIncrease();
+                break;
+
+            case 11:
+                displaySystemStatus();
+                break;
+
+            case 12:
+                printf("\nREINITIALIZING SYSTEM\n");
+                clearQueue();
+                clearPriorityQueue();
+                freeLinkedList();
+                initializeRandomBins();
+                break;
+
+            case 13:
+                printf("\n");
+                printf("    Thank you for using Smart Waste Management System v2.0!     \n");
+                printf("                    Exiting program...                          \n");
+                clearQueue();
+                clearPriorityQueue();
+                freeLinkedList();
+                freeAreaDistances();  // Add this line
+                return 0;
+
+            default:
+                printf("Invalid choice! Please try again.\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,1083 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "core.h"
+#include "bin_index.h"
+#include "distance_tree.h"
+#include "bin_store.h"
+#include "area_table.h"
+#include "spatial_index.h"
+#include "mempool.h"
+#include "fleet.h"
+#include "log.h"
+
+Dustbin* head = NULL; // Global head pointer
+static Dustbin* tail = NULL; // Last node, so addBin appends in O(1)
+static BinIndex binIndex = {0}; // binID -> node, kept in sync with the list
+static SpatialGrid binGrid = {0}; // bin positions, for nearby-bin queries
+static BinStore binStore = {0}; // contiguous copy of the hot fields for scans
+static Pool binPool;            // Dustbin nodes, recycled through a free list
+static int binPoolReady = 0;
+
+// Queue and Priority Queue state (types in core.h). Both distance trees are
+// maintained on every change, so the queues never need re-sorting.
+static DistanceTree normalQueue = {0};       // normal bins, nearest first
+static DistanceTree urgentByDistance = {0};  // same bins as the heap, nearest first
+static priorityqueue* priorityHeap = NULL;
+static int priorityCount = 0;
+static int priorityCapacity = 0;
+
+static pthread_rwlock_t coreLock = PTHREAD_RWLOCK_INITIALIZER;
+
+#define MAX_CHANGE_LISTENERS 8
+typedef struct ChangeListenerEntry {
+    BinChangeListener listener;
+    void* userData;
+} ChangeListenerEntry;
+static ChangeListenerEntry changeListeners[MAX_CHANGE_LISTENERS];
+static int changeListenerCount = 0;
+
+// Function prototypes
+Dustbin* createBin(int id, char* area, float distance, int fillLevel);
+int addBin(int id, char* area, float distance, int fillLevel);
+int deleteBin(int id);
+void displayBins();
+int updateFillLevel(int id, int newFillLevel);
+int validateBinID(int id);
+int validateFillLevel(int fillLevel);
+void initializeRandomBins();
+int getRandomFillLevel();
+Dustbin* findBinByID(int id);
+void freeLinkedList();
+void classify(Dustbin* node);
+void enqueue(Dustbin* node);
+void deletefromqueue(int id);
+void priorityenqueue(Dustbin* dustnode);
+void deletefrompriorityqueue(int id);
+void display();
+void prioritydisplay();
+void queueBinsByDistance();
+void displaySystemStatus();
+void collectBinsFromArea(char* area);
+void simulateTruckCollection();
+void simulateFillLevelIncrease();
+int popPriorityTarget(char *area_buf, float *dist, int *fill);
+int popNormalTarget(char *area_buf, float *dist, int *fill);
+float getAreaDistance(char* area);
+void setAreaDistance(char* area, float distance);
+void freeAreaDistances();
+
+int addBinChangeListener(BinChangeListener listener, void* userData) {
+    if (!listener || changeListenerCount == MAX_CHANGE_LISTENERS) return 0;
+    changeListeners[changeListenerCount].listener = listener;
+    changeListeners[changeListenerCount].userData = userData;
+    changeListenerCount++;
+    return 1;
+}
+
+void removeBinChangeListener(BinChangeListener listener, void* userData) {
+    for (int i = 0; i < changeListenerCount; i++) {
+        if (changeListeners[i].listener == listener && changeListeners[i].userData == userData) {
+            changeListeners[i] = changeListeners[--changeListenerCount];
+            return;
+        }
+    }
+}
+
+static void notifyBinChange(BinChange change, const Dustbin* bin) {
+    for (int i = 0; i < changeListenerCount; i++) {
+        changeListeners[i].listener(change, bin, changeListeners[i].userData);
+    }
+}
+
+// Create a new bin node
+Dustbin* createBin(int id, char* area, float distance, int fillLevel) {
+    if (!binPoolReady) {
+        poolInit(&binPool, sizeof(Dustbin), 1024);
+        binPoolReady = 1;
+    }
+    Dustbin* newBin = (Dustbin*)poolAlloc(&binPool);
+    if (!newBin) {
+        LOG_ERROR("Memory allocation failed!\n");
+        return NULL;
+    }
+    newBin->binID = id;
+    strcpy(newBin->area, area);
+    newBin->distance = distance;
+    newBin->fillLevel = fillLevel;
+    newBin->priority = (fillLevel * 2) - (distance * 5);
+    newBin->areaId = areaIntern(newBin->area);
+    newBin->storeSlot = -1;
+    newBin->areaNext = newBin->areaPrev = NULL;
+    newBin->next = NULL;
+    newBin->prev = NULL;
+    newBin->heapIndex = -1;
+    newBin->rbLeft = newBin->rbRight = newBin->rbParent = NULL;
+    newBin->rbRed = 0;
+    newBin->rbTree = NULL;
+    newBin->x = newBin->y = 0.0f;
+    newBin->gridNext = newBin->gridPrev = NULL;
+    return newBin;
+    }
+
+// Fill-category counters behind getFillSummary, adjusted by every add,
+// delete and fill change so reading them never scans the fleet
+static FillSummary fillCounts = {0};
+static int fillBuckets[FILL_BUCKETS] = {0};
+static unsigned long fleetVersion = 0;
+
+static void countBinFill(int fillLevel, int delta) {
+    fleetVersion++;
+    fillBuckets[fillLevel >= 100 ? FILL_BUCKETS - 1 : fillLevel / 10] += delta;
+    if (fillLevel >= 90) fillCounts.urgent += delta;
+    else if (fillLevel >= 70) fillCounts.high += delta;
+    else if (fillLevel >= 50) fillCounts.medium += delta;
+    else fillCounts.low += delta;
+    if (fillLevel > 0) fillCounts.nonEmpty += delta;
+    fillCounts.total += delta;
+}
+
+int validateBinID(int id) {
+    return binIndexFind(&binIndex, id) == NULL;
+}
+
+int validateFillLevel(int fillLevel) {
+    return (fillLevel >= 0 && fillLevel <= 100);
+}
+// Sideways offset of a placed bin within its area, -0.5 .. 0.5 km, fixed
+// per bin ID so reinitializing puts bins back where they were
+static float binOffsetKm(int id) {
+    uint32_t h = (uint32_t)id * 2654435769u;
+    return (float)(h >> 8) / (float)(1u << 24) - 0.5f;
+}
+
+// position is NULL to place the bin from its area and distance
+static int insertBin(int id, char* area, float distance, int fillLevel, const float* position) {
+    if (!validateBinID(id)) {
+        LOG_ERROR("Error: Bin ID %d already exists!\n", id);
+        return 0;
+    }
+    if (!validateFillLevel(fillLevel)) {
+        LOG_ERROR("Error: Fill level must be between 0 and 100!\n");
+        return 0;
+    }
+    if (distance < 0) {
+        LOG_ERROR("Error: Distance cannot be negative!\n");
+        return 0;
+    }
+    Dustbin* newBin = createBin(id, area, distance, fillLevel);
+    if (!newBin) return 0;
+    if (newBin->areaId < 0 || !binIndexInsert(&binIndex, newBin)) {
+        LOG_ERROR("Memory allocation failed!\n");
+        poolFree(&binPool, newBin);
+        return 0;
+    }
+    if (position) {
+        newBin->x = position[0];
+        newBin->y = position[1];
+    } else {
+        areaPointAt(newBin->areaId, distance, binOffsetKm(id), &newBin->x, &newBin->y);
+    }
+    if (!spatialInsert(&binGrid, newBin)) {
+        LOG_ERROR("Memory allocation failed!\n");
+        binIndexRemove(&binIndex, id);
+        poolFree(&binPool, newBin);
+        return 0;
+    }
+    if (!binStoreAdd(&binStore, newBin)) {
+        LOG_ERROR("Memory allocation failed!\n");
+        spatialRemove(&binGrid, newBin);
+        binIndexRemove(&binIndex, id);
+        poolFree(&binPool, newBin);
+        return 0;
+    }
+    areaAttachBin(newBin);
+    // Areas first seen through a hand-added bin take its distance, so the
+    // route planner can place them
+    if (areaDistance(newBin->areaId) < 0) areaSetDistance(newBin->areaId, distance);
+    countBinFill(newBin->fillLevel, 1);
+    if (!head) {
+        head = tail = newBin;
+    } else {
+        newBin->prev = tail;
+        tail->next = newBin;
+        tail = newBin;
+    }
+    classify(newBin);
+    notifyBinChange(BIN_ADDED, newBin);
+     return 1;
+}
+
+int addBin(int id, char* area, float distance, int fillLevel) {
+    return insertBin(id, area, distance, fillLevel, NULL);
+}
+
+int addBinAt(int id, char* area, float distance, int fillLevel, float x, float y) {
+    float position[2] = {x, y};
+    return insertBin(id, area, distance, fillLevel, position);
+}
+
+int moveBin(int id, float x, float y) {
+    Dustbin* bin = binIndexFind(&binIndex, id);
+    if (!bin) {
+        LOG_ERROR("Bin %d not found!\n", id);
+        return 0;
+    }
+    if (!spatialMove(&binGrid, bin, x, y)) {
+        LOG_ERROR("Memory allocation failed!\n");
+        return 0;
+    }
+    return 1;
+}
+
+int findBinsWithinRadius(float x, float y, float radiusKm, BinFilter filter, void* userData,
+                         Dustbin** out, int max) {
+    return spatialRadius(&binGrid, x, y, radiusKm, filter, userData, out, max);
+}
+
+int findNearestBins(float x, float y, int k, float maxKm, BinFilter filter, void* userData,
+                    Dustbin** out, float* distKm) {
+    return spatialNearest(&binGrid, x, y, k, maxKm, filter, userData, out, distKm);
+}
+
+int deleteBin(int id) {
+    if (!head) {
+        LOG_ERROR("No bins to delete!\n");
+        return 0;
+    }
+    Dustbin* bin = binIndexFind(&binIndex, id);
+    if (!bin) {
+        LOG_ERROR("Bin %d not found!\n", id);
+        return 0;
+    }
+    // Remove from queues before deleting
+    deletefromqueue(id);
+    deletefrompriorityqueue(id);
+    binIndexRemove(&binIndex, id);
+    binStoreRemove(&binStore, bin);
+    spatialRemove(&binGrid, bin);
+    areaDetachBin(bin);
+    countBinFill(bin->fillLevel, -1);
+
+    if (bin->prev) bin->prev->next = bin->next;
+    else head = bin->next;
+    if (bin->next) bin->next->prev = bin->prev;
+    else tail = bin->prev;
+    notifyBinChange(BIN_REMOVED, bin);
+    poolFree(&binPool, bin);
+    LOG_INFO("Bin %d deleted successfully!\n", id);
+    return 1;
+}
+
+void displayBins() {
+    if (!head) {
+        LOG_INFO("No bins available!\n");
+        return;
+    }
+    LOG_INFO("\n=== BIN INVENTORY ===\n");
+    LOG_INFO("ID\tArea\t\tDistance\tFill Level\tStatus\n");
+    LOG_INFO("-----------------------------------------------------------------------\n");
+    Dustbin* current = head;
+    while (current) {
+        char status[20];
+        if (current->fillLevel >= 90) strcpy(status, "URGENT");
+        else if (current->fillLevel >= 70) strcpy(status, "HIGH");
+        else if (current->fillLevel >= 50) strcpy(status, "MEDIUM");
+        else strcpy(status, "LOW");
+         LOG_INFO("%d\t%s\t\t%.2f\t\t%d%%\t\t%s\n", 
+               current->binID, current->area, current->distance, 
+               current->fillLevel, status);
+        current = current->next;
+    }
+    LOG_INFO("-----------------------------------------------------------------------\n");
+}
+
+// Single place where a bin's fill changes, so every mirror stays in sync
+static void setBinFill(Dustbin* bin, int fillLevel) {
+    int oldFill = bin->fillLevel;
+    countBinFill(oldFill, -1);
+    countBinFill(fillLevel, 1);
+    bin->fillLevel = fillLevel;
+    areaUpdateFill(bin, oldFill);
+    bin->priority = (fillLevel * 2) - (bin->distance * 5);
+    binStoreSync(&binStore, bin);
+}
+
+// Put a bin whose fill just changed back into the queue matching its level
+static void requeueBin(Dustbin* bin) {
+    int isUrgent = (bin->fillLevel >= 90);
+    if (isUrgent && bin->heapIndex >= 0) {
+        // Stays urgent: just move it within the heap
+        priorityenqueue(bin);
+    } else if (!isUrgent && bin->rbTree == &normalQueue) {
+        // Stays in the normal queue, whose distance order is unaffected
+    } else {
+        // Reclassify and move to the appropriate queue
+        deletefromqueue(bin->binID);
+        deletefrompriorityqueue(bin->binID);
+        classify(bin);
+    }
+}
+
+int updateFillLevel(int id, int newFillLevel) {
+    if (!validateFillLevel(newFillLevel)) {
+        LOG_ERROR("Error: Fill level must be between 0 and 100!\n");
+        return 0;
+    }
+    Dustbin* bin = findBinByID(id);
+    if (!bin) {
+        LOG_ERROR("Bin %d not found!\n", id);
+        return 0;
+    }
+    int oldLevel = bin->fillLevel;
+    int wasUrgent = (oldLevel >= 90);
+    int isUrgent = (newFillLevel >= 90);
+    
+    setBinFill(bin, newFillLevel);
+    requeueBin(bin);
+    notifyBinChange(BIN_UPDATED, bin);
+    
+    if (!wasUrgent && isUrgent) {
+        LOG_WARN("WARNING: Bin %d is now URGENT and needs immediate collection!\n", id);
+    } else if (wasUrgent && !isUrgent) {
+        LOG_INFO("SUCCESS: Bin %d is no longer urgent.\n", id);
+    }
+    return 1;
+}
+
+Dustbin* findBinByID(int id) {
+    return binIndexFind(&binIndex, id);
+}
+
+int getRandomFillLevel() {
+    return rand() % 101;
+}
+void initializeRandomBins() {
+    LOG_INFO("\nInitializing waste management system with 10 bins...\n");
+    char *areas[] = {
+        "Shivajinagar", "Kothrud", "Koregaon Park", "Viman Nagar", "Hinjewadi",
+        "Baner", "Kharadi", "Hadapsar", "Swargate", "Camp"
+    };
+    int totalAreas = 10;
+    
+    // Clear previous area distances
+    freeAreaDistances();
+    
+    // Assign random distances to each area (between 2 and 20 km)
+    for (int i = 0; i < totalAreas; i++) {
+        float areaDistance = 2.0f + ((float)rand() / RAND_MAX) * 18.0f;
+        setAreaDistance(areas[i], areaDistance);
+    }
+    
+    // Create 10 bins with consistent area distances
+    for (int i = 1; i <= 10; i++) {
+        int randomAreaIndex = rand() % totalAreas;
+        char* selectedArea = areas[randomAreaIndex];
+        
+        // Get the base distance for this area
+        float baseDistance = getAreaDistance(selectedArea);
+        
+        // Add small variation (±0.5 km) to make it realistic
+        float variation = ((float)rand() / RAND_MAX - 0.5f) * 1.0f;
+        float binDistance = baseDistance + variation;
+        if (binDistance < 0.5f) binDistance = 0.5f;
+        
+        int randomFill = getRandomFillLevel();
+        addBin(i, selectedArea, binDistance, randomFill);
+    }
+    LOG_INFO("10 bins initialized successfully with consistent area distances!\n");
+}
+
+// Returns every node to the pool in one step; the slabs are kept for reuse
+// Also empties both queues and every index: they all link through the
+// nodes, so they are dropped before the nodes go back to the pool and
+// callers need not clear anything first
+void freeLinkedList() {
+    distanceTreeClear(&normalQueue);
+    distanceTreeClear(&urgentByDistance);
+    priorityCount = 0;
+    binIndexClear(&binIndex);
+    binStoreClear(&binStore);
+    spatialClear(&binGrid);
+    areaClearBins();
+    head = tail = NULL;
+    if (binPoolReady) poolReset(&binPool);
+    memset(&fillCounts, 0, sizeof(fillCounts));
+    memset(fillBuckets, 0, sizeof(fillBuckets));
+    fleetVersion++;
+    notifyBinChange(BIN_RESET, NULL);
+}
+
+void classify(Dustbin* node) {
+    if (node->fillLevel >= 90) {
+        priorityenqueue(node);
+    } else {
+        enqueue(node);
+    }
+}
+
+void enqueue(Dustbin* node) {
+    if (node->rbTree) return;
+    distanceTreeInsert(&normalQueue, node);
+}
+
+void deletefromqueue(int id) {
+    Dustbin* node = findBinByID(id);
+    if (!node || node->rbTree != &normalQueue) {
+        return;
+    }
+    distanceTreeRemove(&normalQueue, node);
+}
+
+Dustbin* queueFront(void) {
+    return normalQueue.first;
+}
+
+Dustbin* queueNextByDistance(const Dustbin* bin) {
+    return distanceTreeNext(bin);
+}
+
+int queueSize(void) {
+    return normalQueue.count;
+}
+
+int binInPriorityQueue(const Dustbin* bin) {
+    return bin->heapIndex >= 0;
+}
+
+int binInNormalQueue(const Dustbin* bin) {
+    return bin->rbTree == &normalQueue;
+}
+
+Dustbin* queueBinAt(int index) {
+    return distanceTreeSelect(&normalQueue, index);
+}
+
+int queueIndexOf(const Dustbin* bin) {
+    return distanceTreeRank(&normalQueue, bin);
+}
+
+// Store order: insertion order, except a delete moves the last bin into
+// the freed slot
+int binCount(void) {
+    return binStore.count;
+}
+
+Dustbin* binAt(int index) {
+    if (index < 0 || index >= binStore.count) return NULL;
+    return binStore.owner[index];
+}
+
+// Heap helpers: entry a is served before entry b
+static int priorityBefore(const priorityqueue* a, const priorityqueue* b) {
+    if (a->priority != b->priority) return a->priority > b->priority;
+    if (a->distance != b->distance) return a->distance < b->distance;
+    return a->bin->binID < b->bin->binID;
+}
+
+static void priorityPlace(int i, priorityqueue entry) {
+    priorityHeap[i] = entry;
+    entry.bin->heapIndex = i;
+}
+
+static void prioritySiftUp(int i) {
+    priorityqueue entry = priorityHeap[i];
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!priorityBefore(&entry, &priorityHeap[parent])) break;
+        priorityPlace(i, priorityHeap[parent]);
+        i = parent;
+    }
+    priorityPlace(i, entry);
+}
+
+static void prioritySiftDown(int i) {
+    priorityqueue entry = priorityHeap[i];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= priorityCount) break;
+        if (child + 1 < priorityCount && priorityBefore(&priorityHeap[child + 1], &priorityHeap[child]))
+            child++;
+        if (!priorityBefore(&priorityHeap[child], &entry)) break;
+        priorityPlace(i, priorityHeap[child]);
+        i = child;
+    }
+    priorityPlace(i, entry);
+}
+
+static void priorityRemoveAt(int i) {
+    distanceTreeRemove(&urgentByDistance, priorityHeap[i].bin);
+    priorityHeap[i].bin->heapIndex = -1;
+    priorityCount--;
+    if (i == priorityCount) return;
+    Dustbin* moved = priorityHeap[priorityCount].bin;
+    priorityPlace(i, priorityHeap[priorityCount]);
+    prioritySiftUp(i);
+    if (moved->heapIndex == i) prioritySiftDown(i);
+}
+
+// Add a bin at the end of the heap without restoring order
+static int priorityAppend(Dustbin* dustnode) {
+    if (priorityCount == priorityCapacity) {
+        int newCapacity = priorityCapacity ? priorityCapacity * 2 : 16;
+        priorityqueue* grown = (priorityqueue*)coreRealloc(priorityHeap, newCapacity * sizeof(priorityqueue));
+        if (!grown) {
+            LOG_ERROR("Memory allocation error (priority queue)!\n");
+            return 0;
+        }
+        priorityHeap = grown;
+        priorityCapacity = newCapacity;
+    }
+    priorityqueue entry;
+    entry.priority = dustnode->priority;
+    entry.distance = dustnode->distance;
+    entry.bin = dustnode;
+    priorityHeap[priorityCount] = entry;
+    dustnode->heapIndex = priorityCount++;
+    distanceTreeInsert(&urgentByDistance, dustnode);
+    return 1;
+}
+
+// Drop slot i by moving the last entry into it, without restoring order
+static void priorityDetach(int i) {
+    distanceTreeRemove(&urgentByDistance, priorityHeap[i].bin);
+    priorityHeap[i].bin->heapIndex = -1;
+    priorityCount--;
+    if (i < priorityCount) priorityPlace(i, priorityHeap[priorityCount]);
+}
+
+// Bottom-up rebuild, O(n) whatever the heap looked like before
+static void priorityHeapify(void) {
+    for (int i = priorityCount / 2 - 1; i >= 0; i--) prioritySiftDown(i);
+}
+
+// Insert a bin, or re-key it in place if it is already queued
+void priorityenqueue(Dustbin* dustnode) {
+    int i = dustnode->heapIndex;
+    if (i >= 0) {
+        int oldPriority = priorityHeap[i].priority;
+        priorityHeap[i].priority = dustnode->priority;
+        if (dustnode->priority > oldPriority) prioritySiftUp(i);
+        else prioritySiftDown(i);
+        return;
+    }
+    if (priorityAppend(dustnode)) prioritySiftUp(dustnode->heapIndex);
+}
+
+void deletefrompriorityqueue(int id) {
+    Dustbin* bin = findBinByID(id);
+    if (!bin || bin->heapIndex < 0) {
+        return;
+    }
+    priorityRemoveAt(bin->heapIndex);
+}
+
+Dustbin* priorityPeek(void) {
+    return priorityCount > 0 ? priorityHeap[0].bin : NULL;
+}
+
+int priorityQueueSize(void) {
+    return priorityCount;
+}
+
+// Batches touching more than ~1/16 of the heap re-key in place and rebuild
+// it once, instead of sifting after every reading
+#define FILL_BATCH_HEAPIFY_RATIO 16
+
+size_t applyFillUpdates(const FillUpdate* updates, size_t count,
+                        FillTransition* transitions, size_t maxTransitions) {
+    int bulk = count * FILL_BATCH_HEAPIFY_RATIO >= (size_t)priorityCount;
+    // Listeners get one reset instead of per-bin updates on the same terms
+    int announceEach = changeListenerCount > 0 && count * FILL_BATCH_HEAPIFY_RATIO < binIndex.count;
+    size_t changed = 0;
+
+    // Pass 1: new fill levels and priorities; only urgent re-keys touch the queues
+    for (size_t i = 0; i < count; i++) {
+        if (!validateFillLevel(updates[i].fillLevel)) continue;
+        Dustbin* bin = findBinByID(updates[i].binID);
+        if (!bin) continue;
+        int wasUrgent = (bin->fillLevel >= 90);
+        setBinFill(bin, updates[i].fillLevel);
+        int isUrgent = (bin->fillLevel >= 90);
+
+        if (isUrgent && bin->heapIndex >= 0) {
+            if (bulk) priorityHeap[bin->heapIndex].priority = bin->priority;
+            else priorityenqueue(bin);
+        }
+        if (wasUrgent != isUrgent) {
+            if (changed < maxTransitions) {
+                transitions[changed].binID = bin->binID;
+                transitions[changed].nowUrgent = isUrgent;
+            }
+            changed++;
+        }
+    }
+
+    // Pass 2: move bins whose final level no longer matches their queue.
+    // Repeated IDs are harmless since membership is checked, not toggled.
+    for (size_t i = 0; i < count; i++) {
+        Dustbin* bin = findBinByID(updates[i].binID);
+        if (!bin) continue;
+        if (bin->fillLevel >= 90) {
+            if (bin->heapIndex >= 0) continue;
+            if (bin->rbTree == &normalQueue) distanceTreeRemove(&normalQueue, bin);
+            if (bulk) priorityAppend(bin);
+            else priorityenqueue(bin);
+        } else {
+            if (bin->rbTree == &normalQueue) continue;
+            if (bin->heapIndex >= 0) {
+                if (bulk) priorityDetach(bin->heapIndex);
+                else priorityRemoveAt(bin->heapIndex);
+            }
+            enqueue(bin);
+        }
+    }
+
+    if (bulk) priorityHeapify();
+
+    // Listeners only hear about the batch once both queues are in order.
+    // Each bin is announced once however often it was repeated, and only
+    // if at least one of its readings was applied.
+    BinIndex announced = {0};
+    if (announceEach && !binIndexReserve(&announced, count)) announceEach = 0;
+    if (announceEach) {
+        for (size_t i = 0; i < count; i++) {
+            if (!validateFillLevel(updates[i].fillLevel)) continue;
+            Dustbin* bin = findBinByID(updates[i].binID);
+            if (bin && binIndexInsert(&announced, bin)) notifyBinChange(BIN_UPDATED, bin);
+        }
+        binIndexFree(&announced);
+    } else if (changeListenerCount > 0 && count > 0) {
+        notifyBinChange(BIN_RESET, NULL);
+    }
+    return changed;
+}
+
+// The heap's serve order read off the bins themselves (heap entries carry
+// the same keys), so snapshots need nothing but the caller's buffer
+static int binServedBefore(const Dustbin* a, const Dustbin* b) {
+    if (a->priority != b->priority) return a->priority > b->priority;
+    if (a->distance != b->distance) return a->distance < b->distance;
+    return a->binID < b->binID;
+}
+
+static int compareServeOrder(const void* a, const void* b) {
+    const Dustbin* x = *(Dustbin* const*)a;
+    const Dustbin* y = *(Dustbin* const*)b;
+    if (binServedBefore(x, y)) return -1;
+    if (binServedBefore(y, x)) return 1;
+    return 0;
+}
+
+// out[0..n) as a heap with the last-served bin on top
+static void keptSiftUp(Dustbin** out, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!binServedBefore(out[parent], out[i])) break;
+        Dustbin* swap = out[parent];
+        out[parent] = out[i];
+        out[i] = swap;
+        i = parent;
+    }
+}
+
+static void keptSiftDown(Dustbin** out, int n) {
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && binServedBefore(out[child], out[child + 1])) child++;
+        if (!binServedBefore(out[i], out[child])) break;
+        Dustbin* swap = out[child];
+        out[child] = out[i];
+        out[i] = swap;
+        i = child;
+    }
+}
+
+// Copy up to max queued bins into out, in the order they would be popped.
+// Only out is written, so readers sharing the core read lock can call it
+// at the same time. With a short buffer the max first-served bins are
+// kept in out as a bounded heap before sorting.
+int priorityQueueSnapshot(Dustbin** out, int max) {
+    if (priorityCount == 0 || max <= 0) return 0;
+    int n = priorityCount < max ? priorityCount : max;
+    for (int i = 0; i < priorityCount; i++) {
+        Dustbin* bin = priorityHeap[i].bin;
+        if (i < n) {
+            out[i] = bin;
+            if (n < priorityCount) keptSiftUp(out, i);
+        } else if (binServedBefore(bin, out[0])) {
+            out[0] = bin;
+            keptSiftDown(out, n);
+        }
+    }
+    qsort(out, n, sizeof(Dustbin*), compareServeOrder);
+    return n;
+}
+
+void display() {
+    if (!normalQueue.first) {
+        LOG_INFO("Normal queue is empty.\n");
+        return;
+    }
+    Dustbin* temp = normalQueue.first;
+    LOG_INFO("ID\tArea\t\tDistance\tFill Level\n");
+    LOG_INFO("--------------------------------------------------------\n");
+    while (temp) {
+        LOG_INFO("%d\t%s\t\t%.2f\t\t%d%%\n", temp->binID, temp->area, temp->distance, temp->fillLevel);
+        temp = distanceTreeNext(temp);
+    }
+    LOG_INFO("\n");
+}
+
+void prioritydisplay() {
+    if (priorityCount == 0) {
+        LOG_INFO("Priority queue is empty.\n");
+        return;
+    }
+    Dustbin** sorted = (Dustbin**)coreMalloc(priorityCount * sizeof(Dustbin*));
+    if (!sorted) return;
+    int count = priorityQueueSnapshot(sorted, priorityCount);
+    LOG_INFO("ID\tArea\t\tDistance\tFill Level\n");
+    LOG_INFO("--------------------------------------------------------\n");
+    for (int i = 0; i < count; i++) {
+        Dustbin* temp = sorted[i];
+        LOG_INFO("%d\t%s\t\t%.2f\t\t%d%%\n", temp->binID, temp->area, temp->distance, temp->fillLevel);
+    }
+    LOG_INFO("--------------------------------------------------------\n");
+    coreFree(sorted);
+}
+
+void markBinCollectedAndRequeue(int binID) {
+    Dustbin* bin = findBinByID(binID);
+    if (!bin) {
+        return;
+    }
+
+    if (bin->rbTree == &normalQueue) distanceTreeRemove(&normalQueue, bin);
+    if (bin->heapIndex >= 0) priorityRemoveAt(bin->heapIndex);
+    
+    setBinFill(bin, 0);
+    
+    enqueue(bin);
+    notifyBinChange(BIN_UPDATED, bin);
+}
+
+// Area distances live in the interned area table (area_table.h)
+float getAreaDistance(char* area) {
+    return areaDistance(areaLookup(area));
+}
+
+void setAreaDistance(char* area, float distance) {
+    areaSetDistance(areaIntern(area), distance);
+}
+
+// Forgets all area distances. Area ids are only released once no bin
+// refers to them any more.
+void freeAreaDistances() {
+    areaResetDistances();
+    if (!head) areaTableFree();
+}
+
+void collectBinsFromArea(char* area) {
+    if (!area || strlen(area) == 0) return;
+
+    int areaId = areaLookup(area);
+    if (areaBinCount(areaId) == 0) {
+        LOG_INFO("    No other bins in area '%s' to collect.\n", area);
+        return;
+    }
+
+    // Emptying a bin keeps it in the same area bucket, so walk it directly
+    int collected = 0;
+    for (Dustbin* b = areaFirstBin(areaId); b; b = b->areaNext) {
+        if (b->fillLevel == 0) continue; // already empty
+        LOG_DEBUG("    Bin #%d (Fill: %d%%) - COLLECTED\n", b->binID, b->fillLevel);
+        updateFillLevel(b->binID, 0);
+        collected++;
+    }
+    if (collected > 0)
+        LOG_INFO("    Total bins collected from %s: %d\n", area, collected);
+    else
+        LOG_INFO("    No non-empty bins found in %s.\n", area);
+}
+
+
+int popPriorityTarget(char *area_buf, float *dist, int *fill) {
+    if (priorityCount == 0) return -1;
+    Dustbin* bin = priorityHeap[0].bin;
+    int id = bin->binID;
+
+    if (area_buf) strncpy(area_buf, bin->area, 49), area_buf[49] = '\0';
+    if (dist) *dist = bin->distance;
+    if (fill) *fill = bin->fillLevel;
+
+    // remove top
+    priorityRemoveAt(0);
+    notifyBinChange(BIN_UPDATED, bin);
+    return id;
+}
+
+int popNormalTarget(char *area_buf, float *dist, int *fill) {
+    if (!normalQueue.first) return -1;
+    Dustbin* bin = normalQueue.first;
+    int id = bin->binID;
+
+    if (area_buf) strncpy(area_buf, bin->area, 49), area_buf[49] = '\0';
+    if (dist) *dist = bin->distance;
+    if (fill) *fill = bin->fillLevel;
+
+    distanceTreeRemove(&normalQueue, bin);
+    notifyBinChange(BIN_UPDATED, bin);
+    return id;
+}
+
+
+// TRUCK COLLECTION: one round of the whole fleet (fleet.h)
+
+#define FLEET_PLAN_BUDGET_US 20000   // tour improvement, all trucks together
+
+void simulateTruckCollection() {
+    LOG_INFO("\n");
+    LOG_INFO("                 TRUCK DISPATCH SIMULATION (TIMED)            \n");
+    LOG_INFO("---------------------------------------------------------------\n");
+    
+
+    queueBinsByDistance();
+
+    if (fleetSize() == 0) fleetAddDefaultTrucks();
+    int sent = dispatchFleet(FLEET_PLAN_BUDGET_US);
+    if (sent == 0) {
+        LOG_INFO("\nAll bins are empty — no trucks to dispatch.\n");
+        LOG_INFO("---------------------------------------------------------------\n");
+        return;
+    }
+
+    int binsCollected = 0;
+    float totalKm = 0, longestTrip = 0;
+    for (int i = 0; i < sent; i++) {
+        const DispatchSummary* truck = getDispatchSummary(i);
+        binsCollected += truck->binsCollected;
+        totalKm += truck->totalKm;
+        if (truck->totalTimeMinutes > longestTrip) longestTrip = truck->totalTimeMinutes;
+    }
+
+    LOG_INFO("\n  Fleet Summary:\n");
+    LOG_INFO("   Trucks Dispatched:   %d of %d\n", sent, fleetSize());
+    LOG_INFO("   Distance Driven:     %.1f km\n", totalKm);
+    LOG_INFO("   Longest Trip:        %.1f min\n", longestTrip);
+    LOG_INFO("   Bins Collected:      %d\n", binsCollected);
+    
+    // Display queues after collection (a full listing, so debug output only)
+    if (LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        LOG_DEBUG("\n=== QUEUE STATUS AFTER COLLECTION ===\n");
+        LOG_DEBUG("\nPriority Queue (Urgent):\n");
+        prioritydisplay();
+        LOG_DEBUG("\nNormal Queue:\n");
+        display();
+    }
+    LOG_INFO("---------------------------------------------------------------\n");
+    LOG_INFO("   Collection complete! Trucks returned to their depots.\n");
+    LOG_INFO("   Select option 9 again to dispatch the next round.\n");
+    LOG_INFO("---------------------------------------------------------------\n");
+
+    // Count remaining non-empty bins
+    FillSummary summary;
+    getFillSummary(&summary);
+    int remainingBins = summary.nonEmpty;
+
+    if (remainingBins > 0) {
+        LOG_INFO("\n Remaining bins to collect: %d\n", remainingBins);
+        LOG_INFO("   Select option 9 again to continue collection.\n");
+    }
+}
+
+
+void simulateFillLevelIncrease() {
+    LOG_INFO("\nSimulating passage of time - bins filling up...\n");
+    
+    size_t total = binIndex.count;
+    if (total == 0) {
+        LOG_INFO("0 bins updated with new fill levels\n");
+        return;
+    }
+    // Owned by this call: listeners run inside applyFillUpdates and may
+    // use the core themselves
+    FillUpdate* updates = (FillUpdate*)coreMalloc(total * sizeof(FillUpdate));
+    FillTransition* transitions = (FillTransition*)coreMalloc(total * sizeof(FillTransition));
+    if (!updates || !transitions) {
+        LOG_ERROR("Memory allocation error (fill update batch)!\n");
+        coreFree(updates);
+        coreFree(transitions);
+        return;
+    }
+
+    size_t updated = 0;
+    for (Dustbin* current = head; current; current = current->next) {
+        int increase = (rand() % 20) + 5; // Random increase 5-24%
+        int newLevel = current->fillLevel + increase;
+        if (newLevel > 100) newLevel = 100;
+        
+        if (current->fillLevel < newLevel) {
+            updates[updated].binID = current->binID;
+            updates[updated].fillLevel = newLevel;
+            updated++;
+        }
+    }
+
+    size_t changed = applyFillUpdates(updates, updated, transitions, total);
+    for (size_t i = 0; i < changed; i++) {
+        if (transitions[i].nowUrgent) {
+            LOG_WARN("WARNING: Bin %d is now URGENT and needs immediate collection!\n", transitions[i].binID);
+        } else {
+            LOG_INFO("SUCCESS: Bin %d is no longer urgent.\n", transitions[i].binID);
+        }
+    }
+    LOG_INFO("%zu bins updated with new fill levels\n", updated);
+    coreFree(updates);
+    coreFree(transitions);
+}
+
+void displaySystemStatus() {
+    LOG_INFO("\n");
+    LOG_INFO("                    SYSTEM STATUS OVERVIEW                      \n");
+    
+    FillSummary summary;
+    getFillSummary(&summary);
+    int totalBins = summary.total, urgentBins = summary.urgent, highBins = summary.high;
+    int mediumBins = summary.medium, lowBins = summary.low;
+    
+    LOG_INFO("\n Statistics:\n");
+    LOG_INFO("   Total Bins: %d\n", totalBins);
+    LOG_INFO("Urgent (≥90%%): %d bins\n", urgentBins);
+    LOG_INFO("High (70-89%%): %d bins\n", highBins);
+    LOG_INFO("Medium (50-69%%): %d bins\n", mediumBins);
+    LOG_INFO("Low (<50%%): %d bins\n", lowBins);
+    
+    if (urgentBins > 0) {
+        LOG_WARN("\nWARNING: %d bins require immediate attention!\n", urgentBins);
+    } else {
+        LOG_INFO("\nNo urgent bins - System operating normally\n");
+    }
+}
+
+void clearQueue() {
+    distanceTreeClear(&normalQueue);
+    notifyBinChange(BIN_RESET, NULL);
+}
+
+void clearPriorityQueue() {
+    for (int i = 0; i < priorityCount; i++) {
+        priorityHeap[i].bin->heapIndex = -1;
+    }
+    priorityCount = 0;
+    distanceTreeClear(&urgentByDistance);
+    notifyBinChange(BIN_RESET, NULL);
+}
+
+static void displayByDistance(const DistanceTree* tree) {
+    if (!LOG_ENABLED(LOG_LEVEL_DEBUG)) return;
+    LOG_DEBUG("--------------------------------------------------------\n");
+    LOG_DEBUG("ID\tArea\t\tDistance\tFill Level\n");
+    LOG_DEBUG("--------------------------------------------------------\n");
+    for (Dustbin* b = tree->first; b; b = distanceTreeNext(b)) {
+        LOG_DEBUG("%-8d %-15s %-10.2f %d%%\n", b->binID, b->area, b->distance, b->fillLevel);
+    }
+    LOG_DEBUG("--------------------------------------------------------\n");
+}
+
+// Both queues are kept in distance order as bins change, so this only
+// reports the current order; there is nothing to rebuild.
+void queueBinsByDistance() {
+    if (!head) {
+        LOG_INFO("No bins available to sort!\n");
+        return;
+    }
+
+    LOG_INFO("\n=== Priority Bins Sorted by Distance ===\n");
+    if (urgentByDistance.count > 0) {
+        displayByDistance(&urgentByDistance);
+    } else {
+        LOG_INFO("No priority bins.\n");
+    }
+
+    LOG_INFO("\n=== Normal Bins Sorted by Distance ===\n");
+    if (normalQueue.count > 0) {
+        displayByDistance(&normalQueue);
+    } else {
+        LOG_INFO("No normal bins.\n");
+    }
+
+    LOG_INFO("\nBins have been sorted and enqueued by distance successfully!\n");
+}
+
+void getFillSummary(FillSummary* out) {
+    *out = fillCounts;
+}
+
+int verifyFillCounters(void) {
+    FillScan scan;
+    binStoreScanFill(&binStore, &scan);
+    FillSummary recount;
+    recount.total = scan.total;
+    recount.urgent = scan.atLeast90;
+    recount.high = scan.atLeast70 - scan.atLeast90;
+    recount.medium = scan.atLeast50 - scan.atLeast70;
+    recount.low = scan.total - scan.atLeast50;
+    recount.nonEmpty = scan.total - scan.empty;
+    if (memcmp(&recount, &fillCounts, sizeof(recount)) == 0) return 1;
+
+    LOG_ERROR("Fill counters out of step: counted %d/%d/%d/%d/%d of %d, scanned %d/%d/%d/%d/%d of %d "
+              "(urgent/high/medium/low/non-empty of total)\n",
+              fillCounts.urgent, fillCounts.high, fillCounts.medium, fillCounts.low, fillCounts.nonEmpty,
+              fillCounts.total, recount.urgent, recount.high, recount.medium, recount.low,
+              recount.nonEmpty, recount.total);
+    return 0;
+}
+
+void getFillHistogram(int buckets[FILL_BUCKETS]) {
+    memcpy(buckets, fillBuckets, sizeof(fillBuckets));
+}
+
+int getAreaFillStats(AreaFillStats* out, int max) {
+    int written = 0;
+    for (int id = 0; id < areaCount() && written < max; id++) {
+        int bins = areaBinCount(id);
+        if (bins == 0) continue;
+        out[written].area = areaName(id);
+        out[written].bins = bins;
+        out[written].urgent = areaUrgentCount(id);
+        out[written].averageFill = (float)areaFillSum(id) / bins;
+        written++;
+    }
+    return written;
+}
+
+unsigned long getFleetVersion(void) {
+    return fleetVersion;
+}
+
+
+void coreReadLock(void) {
+    pthread_rwlock_rdlock(&coreLock);
+}
+
+int coreTryReadLock(void) {
+    return pthread_rwlock_tryrdlock(&coreLock) == 0;
+}
+
+void coreReadUnlock(void) {
+    pthread_rwlock_unlock(&coreLock);
+}
+
+void coreWriteLock(void) {
+    pthread_rwlock_wrlock(&coreLock);
+}
+
+void coreWriteUnlock(void) {
+    pthread_rwlock_unlock(&coreLock);
+}
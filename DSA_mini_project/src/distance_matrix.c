@@ -0,0 +1,412 @@
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "distance_matrix.h"
+#include "area_table.h"
+#include "mempool.h"
+#include "log.h"
+
+#define NAME_BYTES 50       // same as AreaEntry / Dustbin names
+#define CELL_ALIGN 64
+
+typedef struct MatrixFileHeader {
+    char magic[8];
+    uint32_t areas;
+    uint32_t nameBytes;
+    uint64_t cellsOffset;   // multiple of CELL_ALIGN
+    char reserved[40];
+} MatrixFileHeader;
+
+static const char matrixMagic[8] = "SWDMAT1";
+
+// Pairs loaded from a file, in the file's own area order. Missing pairs
+// are NAN and fall back to the planar estimate.
+typedef struct MatrixSource {
+    int areas;
+    const char* names;      // areas records of NAME_BYTES
+    const float* cells;
+    int complete;           // binary file: every pair present, usable in place
+    void* block;            // heap copy (CSV, or no mmap on this platform)
+    void* mapping;
+    size_t mappingSize;
+} MatrixSource;
+
+static MatrixSource source;
+
+static DistanceMatrix matrix;
+static void* matrixBlock = NULL;    // owned cells, NULL while borrowing the source
+static unsigned long builtVersion = 0;
+static int built = 0;
+
+// coreMalloc takes no alignment, so over-allocate and keep the base
+static void* allocAligned(size_t bytes, void** block) {
+    *block = coreMalloc(bytes + CELL_ALIGN);
+    if (!*block) return NULL;
+    uintptr_t p = ((uintptr_t)*block + CELL_ALIGN - 1) & ~(uintptr_t)(CELL_ALIGN - 1);
+    return (void*)p;
+}
+
+static size_t cellCount(int areas) {
+    return areas > 1 ? distanceMatrixIndex(areas, 0) : 0;
+}
+
+static void releaseMatrix(void) {
+    coreFree(matrixBlock);
+    matrixBlock = NULL;
+    matrix.areas = 0;
+    matrix.cells = NULL;
+}
+
+static void releaseSource(void) {
+#ifndef _WIN32
+    if (source.mapping) munmap(source.mapping, source.mappingSize);
+#endif
+    coreFree(source.block);
+    memset(&source, 0, sizeof(source));
+}
+
+// --------------------------------------------------------------
+// BUILDING
+// --------------------------------------------------------------
+static void rebuild(void) {
+    releaseMatrix();
+    built = 1;
+    builtVersion = areaGeometryVersion();
+
+    int n = areaCount();
+    if (n > DISTANCE_MATRIX_MAX_AREAS) n = DISTANCE_MATRIX_MAX_AREAS;
+    if (n == 0) return;
+
+    // Where each covered area sits in the loaded file, -1 if absent
+    int* fromSource = NULL;
+    int inPlace = 0;
+    if (source.areas > 0) {
+        fromSource = (int*)coreMalloc(n * sizeof(int));
+        if (!fromSource) return;
+        for (int id = 0; id < n; id++) fromSource[id] = -1;
+        for (int i = 0; i < source.areas; i++) {
+            int id = areaLookup(source.names + (size_t)i * NAME_BYTES);
+            if (id >= 0 && id < n) fromSource[id] = i;
+        }
+        // The first n rows of a triangle are the triangle for n areas. A CSV
+        // source may have NAN gaps, which only the copy below fills in.
+        inPlace = source.complete && n <= source.areas;
+        for (int id = 0; id < n && inPlace; id++) inPlace = fromSource[id] == id;
+    }
+
+    if (inPlace) {
+        matrix.cells = source.cells;
+        matrix.areas = n;
+        coreFree(fromSource);
+        return;
+    }
+
+    size_t count = cellCount(n);
+    float* cells = (float*)allocAligned((count ? count : 1) * sizeof(float), &matrixBlock);
+    if (!cells) {
+        LOG_ERROR("Memory allocation error (distance matrix, %d areas)!\n", n);
+        coreFree(fromSource);
+        return;
+    }
+    DistanceMatrix loaded = {source.areas, source.cells};
+    for (int a = 1; a < n; a++) {
+        float* row = cells + distanceMatrixIndex(a, 0);
+        int sa = fromSource ? fromSource[a] : -1;
+        for (int b = 0; b < a; b++) {
+            int sb = fromSource ? fromSource[b] : -1;
+            float km = (sa >= 0 && sb >= 0) ? distanceMatrixAt(&loaded, sa, sb) : NAN;
+            row[b] = isnan(km) ? areaTravelKm(a, b) : km;
+        }
+    }
+    matrix.cells = cells;
+    matrix.areas = n;
+    coreFree(fromSource);
+}
+
+const DistanceMatrix* distanceMatrixCurrent(void) {
+    if (!built || builtVersion != areaGeometryVersion()) rebuild();
+    return matrix.areas > 0 ? &matrix : NULL;
+}
+
+float distanceMatrixKm(int a, int b) {
+    return distanceMatrixLegKm(distanceMatrixCurrent(), a, b);
+}
+
+void distanceMatrixFree(void) {
+    releaseMatrix();
+    releaseSource();
+    built = 0;
+}
+
+// --------------------------------------------------------------
+// CSV FILES
+// --------------------------------------------------------------
+static char* trim(char* s) {
+    while (*s == ' ' || *s == '\t') s++;
+    char* end = s + strlen(s);
+    while (end > s && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n')) end--;
+    *end = '\0';
+    return s;
+}
+
+// Splits "from,to,km" in place; returns 0 for blank, comment or bad lines
+static int parsePair(char* line, char** from, char** to, float* km) {
+    char* text = trim(line);
+    if (*text == '\0' || *text == '#') return 0;
+    char* comma1 = strchr(text, ',');
+    char* comma2 = comma1 ? strchr(comma1 + 1, ',') : NULL;
+    if (!comma2) return -1;
+    *comma1 = *comma2 = '\0';
+    *from = trim(text);
+    *to = trim(comma1 + 1);
+    char* end;
+    *km = strtof(comma2 + 1, &end);
+    if (end == comma2 + 1 || **from == '\0' || **to == '\0' || *km < 0) return -1;
+    return 1;
+}
+
+static int compareNames(const void* a, const void* b) {
+    return strncmp((const char*)a, (const char*)b, NAME_BYTES);
+}
+
+static void addName(char* names, int* count, const char* name) {
+    char* slot = names + (size_t)*count * NAME_BYTES;
+    strncpy(slot, name, NAME_BYTES - 1);
+    slot[NAME_BYTES - 1] = '\0';
+    (*count)++;
+}
+
+// Two passes: collect and sort the distinct names, then fill the pairs
+int distanceMatrixLoadCsv(const char* path) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        LOG_WARN("Cannot open distance file %s\n", path);
+        return 0;
+    }
+
+    char line[256];
+    char *from, *to;
+    float km;
+    int names = 0, nameCapacity = 64;
+    char* nameTable = (char*)coreMalloc((size_t)nameCapacity * NAME_BYTES);
+    while (nameTable && fgets(line, sizeof(line), in)) {
+        if (parsePair(line, &from, &to, &km) <= 0) continue;
+        if (names + 2 > nameCapacity) {
+            nameCapacity *= 2;
+            char* grown = (char*)coreRealloc(nameTable, (size_t)nameCapacity * NAME_BYTES);
+            if (!grown) {
+                coreFree(nameTable);
+                nameTable = NULL;
+                break;
+            }
+            nameTable = grown;
+        }
+        addName(nameTable, &names, from);
+        addName(nameTable, &names, to);
+    }
+    if (!nameTable) {
+        LOG_ERROR("Memory allocation error (distance file names)!\n");
+        fclose(in);
+        return 0;
+    }
+
+    qsort(nameTable, names, NAME_BYTES, compareNames);
+    int distinct = 0;
+    for (int i = 0; i < names; i++) {
+        if (distinct > 0 && compareNames(nameTable + (size_t)(distinct - 1) * NAME_BYTES,
+                                         nameTable + (size_t)i * NAME_BYTES) == 0) continue;
+        memmove(nameTable + (size_t)distinct * NAME_BYTES, nameTable + (size_t)i * NAME_BYTES, NAME_BYTES);
+        distinct++;
+    }
+    if (distinct > DISTANCE_MATRIX_MAX_AREAS) {
+        LOG_WARN("Distance file %s names %d areas; only %d are kept\n", path, distinct, DISTANCE_MATRIX_MAX_AREAS);
+        distinct = DISTANCE_MATRIX_MAX_AREAS;
+    }
+
+    size_t count = cellCount(distinct);
+    float* cells = (float*)coreMalloc((count ? count : 1) * sizeof(float));
+    if (!cells) {
+        LOG_ERROR("Memory allocation error (distance file, %d areas)!\n", distinct);
+        coreFree(nameTable);
+        fclose(in);
+        return 0;
+    }
+    for (size_t i = 0; i < count; i++) cells[i] = NAN;
+
+    rewind(in);
+    int lineNo = 0, pairs = 0;
+    while (fgets(line, sizeof(line), in)) {
+        lineNo++;
+        int parsed = parsePair(line, &from, &to, &km);
+        if (parsed < 0) LOG_WARN("%s:%d: expected \"from,to,km\"\n", path, lineNo);
+        if (parsed <= 0) continue;
+        char key[NAME_BYTES] = {0};
+        strncpy(key, from, NAME_BYTES - 1);
+        char* a = (char*)bsearch(key, nameTable, distinct, NAME_BYTES, compareNames);
+        memset(key, 0, sizeof(key));
+        strncpy(key, to, NAME_BYTES - 1);
+        char* b = (char*)bsearch(key, nameTable, distinct, NAME_BYTES, compareNames);
+        if (!a || !b || a == b) continue;
+        int ia = (int)((a - nameTable) / NAME_BYTES), ib = (int)((b - nameTable) / NAME_BYTES);
+        cells[ia > ib ? distanceMatrixIndex(ia, ib) : distanceMatrixIndex(ib, ia)] = km;
+        pairs++;
+    }
+    fclose(in);
+
+    // The cells block holds both, so the source owns a single allocation
+    char* merged = (char*)coreRealloc(nameTable, (size_t)distinct * NAME_BYTES + (count ? count : 1) * sizeof(float));
+    if (!merged) {
+        coreFree(nameTable);
+        coreFree(cells);
+        return 0;
+    }
+    memcpy(merged + (size_t)distinct * NAME_BYTES, cells, count * sizeof(float));
+    coreFree(cells);
+
+    releaseSource();
+    source.areas = distinct;
+    source.names = merged;
+    source.cells = (const float*)(merged + (size_t)distinct * NAME_BYTES);
+    source.block = merged;
+    built = 0;
+    LOG_INFO("Loaded %d area distances over %d areas from %s\n", pairs, distinct, path);
+    return 1;
+}
+
+// --------------------------------------------------------------
+// BINARY FILES
+// --------------------------------------------------------------
+int distanceMatrixSave(const char* path) {
+    const DistanceMatrix* m = distanceMatrixCurrent();
+    int areas = m ? m->areas : 0;
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        LOG_WARN("Cannot write distance file %s\n", path);
+        return 0;
+    }
+
+    MatrixFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, matrixMagic, sizeof(header.magic));
+    header.areas = (uint32_t)areas;
+    header.nameBytes = NAME_BYTES;
+    uint64_t namesEnd = sizeof(header) + (uint64_t)areas * NAME_BYTES;
+    header.cellsOffset = (namesEnd + CELL_ALIGN - 1) & ~(uint64_t)(CELL_ALIGN - 1);
+
+    int ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    for (int id = 0; id < areas && ok; id++) {
+        char record[NAME_BYTES] = {0};
+        strncpy(record, areaName(id), NAME_BYTES - 1);
+        ok = fwrite(record, NAME_BYTES, 1, out) == 1;
+    }
+    static const char padding[CELL_ALIGN];
+    size_t pad = (size_t)(header.cellsOffset - namesEnd);
+    if (ok && pad) ok = fwrite(padding, 1, pad, out) == pad;
+    size_t count = cellCount(areas);
+    if (ok && count) ok = fwrite(m->cells, sizeof(float), count, out) == count;
+    if (fclose(out) != 0) ok = 0;
+    if (!ok) LOG_WARN("Error writing distance file %s\n", path);
+    return ok;
+}
+
+static int validHeader(const MatrixFileHeader* header, size_t fileSize) {
+    if (memcmp(header->magic, matrixMagic, sizeof(header->magic)) != 0) return 0;
+    if (header->nameBytes != NAME_BYTES || header->areas > DISTANCE_MATRIX_MAX_AREAS) return 0;
+    if (header->cellsOffset % CELL_ALIGN != 0) return 0;
+    // Every bound is checked against what is left of the file, so a huge
+    // offset can't wrap around into range
+    uint64_t namesEnd = sizeof(*header) + (uint64_t)header->areas * NAME_BYTES;
+    if (namesEnd > fileSize || header->cellsOffset < namesEnd) return 0;
+    uint64_t cellBytes = (uint64_t)cellCount((int)header->areas) * sizeof(float);
+    if (header->cellsOffset > fileSize || cellBytes > fileSize - header->cellsOffset) return 0;
+    // Names are used in place as C strings, so each record must end in one
+    const char* names = (const char*)(header + 1);
+    for (uint32_t i = 0; i < header->areas; i++) {
+        if (!memchr(names + (size_t)i * NAME_BYTES, '\0', NAME_BYTES)) return 0;
+    }
+    return 1;
+}
+
+int distanceMatrixMap(const char* path) {
+    void* data = NULL;
+    void* block = NULL;
+    size_t size = 0;
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        LOG_WARN("Cannot open distance file %s\n", path);
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= (off_t)sizeof(MatrixFileHeader)) {
+        size = (size_t)info.st_size;
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) data = NULL;
+    }
+    close(fd);
+#else
+    // No mmap: read the file into one aligned block instead
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        LOG_WARN("Cannot open distance file %s\n", path);
+        return 0;
+    }
+    if (fseek(in, 0, SEEK_END) == 0) {
+        long length = ftell(in);
+        rewind(in);
+        if (length >= (long)sizeof(MatrixFileHeader)) {
+            size = (size_t)length;
+            data = allocAligned(size, &block);
+            if (data && fread(data, 1, size, in) != size) {
+                coreFree(block);
+                data = block = NULL;
+            }
+        }
+    }
+    fclose(in);
+#endif
+    if (!data || !validHeader((const MatrixFileHeader*)data, size)) {
+        LOG_WARN("%s is not a distance matrix file\n", path);
+#ifndef _WIN32
+        if (data) munmap(data, size);
+#endif
+        coreFree(block);
+        return 0;
+    }
+
+    const MatrixFileHeader* header = (const MatrixFileHeader*)data;
+    releaseSource();
+    source.areas = (int)header->areas;
+    source.names = (const char*)data + sizeof(*header);
+    source.cells = (const float*)((const char*)data + header->cellsOffset);
+    source.complete = 1;
+    source.block = block;
+#ifndef _WIN32
+    source.mapping = data;
+    source.mappingSize = size;
+#endif
+    built = 0;
+    LOG_INFO("Mapped distances for %d areas from %s\n", source.areas, path);
+    return 1;
+}
+
+int distanceMatrixOpen(const char* path) {
+    char magic[sizeof(matrixMagic)] = {0};
+    FILE* in = fopen(path, "rb");
+    if (!in) {
+        LOG_WARN("Cannot open distance file %s\n", path);
+        return 0;
+    }
+    size_t got = fread(magic, 1, sizeof(magic), in);
+    fclose(in);
+    if (got == sizeof(magic) && memcmp(magic, matrixMagic, sizeof(magic)) == 0) return distanceMatrixMap(path);
+    return distanceMatrixLoadCsv(path);
+}
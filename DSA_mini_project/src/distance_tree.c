@@ -0,0 +1,280 @@
+#include <stddef.h>
+#include "distance_tree.h"
+#include "core.h"
+
+// Strict ordering used by the tree: nearest first, binID breaks ties
+static int before(const Dustbin* a, const Dustbin* b) {
+    if (a->distance != b->distance) return a->distance < b->distance;
+    return a->binID < b->binID;
+}
+
+static int isRed(const Dustbin* node) {
+    return node && node->rbRed;
+}
+
+static int sizeOf(const Dustbin* node) {
+    return node ? node->rbSize : 0;
+}
+
+static void replaceChild(DistanceTree* tree, Dustbin* parent, Dustbin* oldChild, Dustbin* newChild) {
+    if (!parent) tree->root = newChild;
+    else if (parent->rbLeft == oldChild) parent->rbLeft = newChild;
+    else parent->rbRight = newChild;
+    if (newChild) newChild->rbParent = parent;
+}
+
+static void rotateLeft(DistanceTree* tree, Dustbin* x) {
+    Dustbin* y = x->rbRight;
+    x->rbRight = y->rbLeft;
+    if (y->rbLeft) y->rbLeft->rbParent = x;
+    replaceChild(tree, x->rbParent, x, y);
+    y->rbLeft = x;
+    x->rbParent = y;
+    y->rbSize = x->rbSize;
+    x->rbSize = sizeOf(x->rbLeft) + sizeOf(x->rbRight) + 1;
+}
+
+static void rotateRight(DistanceTree* tree, Dustbin* x) {
+    Dustbin* y = x->rbLeft;
+    x->rbLeft = y->rbRight;
+    if (y->rbRight) y->rbRight->rbParent = x;
+    replaceChild(tree, x->rbParent, x, y);
+    y->rbRight = x;
+    x->rbParent = y;
+    y->rbSize = x->rbSize;
+    x->rbSize = sizeOf(x->rbLeft) + sizeOf(x->rbRight) + 1;
+}
+
+static void insertFixup(DistanceTree* tree, Dustbin* z) {
+    Dustbin* p;
+    while ((p = z->rbParent) && p->rbRed) {
+        Dustbin* g = p->rbParent;   // exists: a red node is never the root
+        if (p == g->rbLeft) {
+            Dustbin* uncle = g->rbRight;
+            if (isRed(uncle)) {
+                p->rbRed = 0;
+                uncle->rbRed = 0;
+                g->rbRed = 1;
+                z = g;
+                continue;
+            }
+            if (z == p->rbRight) {
+                rotateLeft(tree, p);
+                z = p;
+                p = z->rbParent;
+            }
+            p->rbRed = 0;
+            g->rbRed = 1;
+            rotateRight(tree, g);
+        } else {
+            Dustbin* uncle = g->rbLeft;
+            if (isRed(uncle)) {
+                p->rbRed = 0;
+                uncle->rbRed = 0;
+                g->rbRed = 1;
+                z = g;
+                continue;
+            }
+            if (z == p->rbLeft) {
+                rotateRight(tree, p);
+                z = p;
+                p = z->rbParent;
+            }
+            p->rbRed = 0;
+            g->rbRed = 1;
+            rotateLeft(tree, g);
+        }
+    }
+    tree->root->rbRed = 0;
+}
+
+// x may be NULL (an empty leaf), so its parent is passed explicitly
+static void removeFixup(DistanceTree* tree, Dustbin* x, Dustbin* parent) {
+    while (x != tree->root && !isRed(x)) {
+        if (x == parent->rbLeft) {
+            Dustbin* w = parent->rbRight;
+            if (w->rbRed) {
+                w->rbRed = 0;
+                parent->rbRed = 1;
+                rotateLeft(tree, parent);
+                w = parent->rbRight;
+            }
+            if (!isRed(w->rbLeft) && !isRed(w->rbRight)) {
+                w->rbRed = 1;
+                x = parent;
+                parent = x->rbParent;
+            } else {
+                if (!isRed(w->rbRight)) {
+                    w->rbLeft->rbRed = 0;
+                    w->rbRed = 1;
+                    rotateRight(tree, w);
+                    w = parent->rbRight;
+                }
+                w->rbRed = parent->rbRed;
+                parent->rbRed = 0;
+                if (w->rbRight) w->rbRight->rbRed = 0;
+                rotateLeft(tree, parent);
+                x = tree->root;
+            }
+        } else {
+            Dustbin* w = parent->rbLeft;
+            if (w->rbRed) {
+                w->rbRed = 0;
+                parent->rbRed = 1;
+                rotateRight(tree, parent);
+                w = parent->rbLeft;
+            }
+            if (!isRed(w->rbLeft) && !isRed(w->rbRight)) {
+                w->rbRed = 1;
+                x = parent;
+                parent = x->rbParent;
+            } else {
+                if (!isRed(w->rbLeft)) {
+                    w->rbRight->rbRed = 0;
+                    w->rbRed = 1;
+                    rotateLeft(tree, w);
+                    w = parent->rbLeft;
+                }
+                w->rbRed = parent->rbRed;
+                parent->rbRed = 0;
+                if (w->rbLeft) w->rbLeft->rbRed = 0;
+                rotateRight(tree, parent);
+                x = tree->root;
+            }
+        }
+    }
+    if (x) x->rbRed = 0;
+}
+
+void distanceTreeInsert(DistanceTree* tree, Dustbin* bin) {
+    Dustbin* parent = NULL;
+    Dustbin** link = &tree->root;
+    int leftmost = 1;
+    while (*link) {
+        parent = *link;
+        parent->rbSize++;
+        if (before(bin, parent)) {
+            link = &parent->rbLeft;
+        } else {
+            link = &parent->rbRight;
+            leftmost = 0;
+        }
+    }
+    bin->rbParent = parent;
+    bin->rbLeft = bin->rbRight = NULL;
+    bin->rbRed = 1;
+    bin->rbSize = 1;
+    bin->rbTree = tree;
+    *link = bin;
+    if (leftmost) tree->first = bin;
+    tree->count++;
+    insertFixup(tree, bin);
+}
+
+void distanceTreeRemove(DistanceTree* tree, Dustbin* z) {
+    if (tree->first == z) tree->first = distanceTreeNext(z);
+
+    Dustbin* x;
+    Dustbin* xParent;
+    int removedRed = z->rbRed;
+
+    // Every ancestor of the node that physically leaves the tree loses one
+    Dustbin* spliced = z;
+    if (z->rbLeft && z->rbRight) {
+        spliced = z->rbRight;
+        while (spliced->rbLeft) spliced = spliced->rbLeft;
+    }
+    for (Dustbin* p = spliced->rbParent; p; p = p->rbParent) p->rbSize--;
+
+    if (!z->rbLeft) {
+        x = z->rbRight;
+        xParent = z->rbParent;
+        replaceChild(tree, z->rbParent, z, z->rbRight);
+    } else if (!z->rbRight) {
+        x = z->rbLeft;
+        xParent = z->rbParent;
+        replaceChild(tree, z->rbParent, z, z->rbLeft);
+    } else {
+        // Splice in the in-order successor, which has no left child
+        Dustbin* y = z->rbRight;
+        while (y->rbLeft) y = y->rbLeft;
+        removedRed = y->rbRed;
+        x = y->rbRight;
+        if (y->rbParent == z) {
+            xParent = y;
+        } else {
+            xParent = y->rbParent;
+            replaceChild(tree, y->rbParent, y, y->rbRight);
+            y->rbRight = z->rbRight;
+            y->rbRight->rbParent = y;
+        }
+        replaceChild(tree, z->rbParent, z, y);
+        y->rbLeft = z->rbLeft;
+        y->rbLeft->rbParent = y;
+        y->rbRed = z->rbRed;
+        y->rbSize = z->rbSize;
+    }
+    if (!removedRed) removeFixup(tree, x, xParent);
+
+    z->rbLeft = z->rbRight = z->rbParent = NULL;
+    z->rbTree = NULL;
+    tree->count--;
+}
+
+Dustbin* distanceTreeNext(const Dustbin* bin) {
+    if (bin->rbRight) {
+        const Dustbin* n = bin->rbRight;
+        while (n->rbLeft) n = n->rbLeft;
+        return (Dustbin*)n;
+    }
+    while (bin->rbParent && bin == bin->rbParent->rbRight) bin = bin->rbParent;
+    return bin->rbParent;
+}
+
+static void detachSubtree(Dustbin* node) {
+    if (!node) return;
+    detachSubtree(node->rbLeft);
+    detachSubtree(node->rbRight);
+    node->rbLeft = node->rbRight = node->rbParent = NULL;
+    node->rbTree = NULL;
+}
+
+// The index-th bin in tree order (0 = nearest), or NULL if out of range
+Dustbin* distanceTreeSelect(const DistanceTree* tree, int index) {
+    Dustbin* node = tree->root;
+    while (node) {
+        int leftSize = sizeOf(node->rbLeft);
+        if (index < leftSize) {
+            node = node->rbLeft;
+        } else if (index == leftSize) {
+            return node;
+        } else {
+            index -= leftSize + 1;
+            node = node->rbRight;
+        }
+    }
+    return NULL;
+}
+
+// Number of bins ordered before this one. Works whether or not the bin is
+// in the tree, so it also gives the position a just-removed bin had.
+int distanceTreeRank(const DistanceTree* tree, const Dustbin* bin) {
+    int rank = 0;
+    const Dustbin* node = tree->root;
+    while (node) {
+        if (before(node, bin)) {
+            rank += sizeOf(node->rbLeft) + 1;
+            node = node->rbRight;
+        } else {
+            node = node->rbLeft;
+        }
+    }
+    return rank;
+}
+
+// Depth is O(log n), so the recursion here is bounded
+void distanceTreeClear(DistanceTree* tree) {
+    detachSubtree(tree->root);
+    tree->root = tree->first = NULL;
+    tree->count = 0;
+}
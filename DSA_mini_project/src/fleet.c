@@ -0,0 +1,491 @@
+#include <stdio.h>
+#include <string.h>
+#include "fleet.h"
+#include "distance_matrix.h"
+#include "route_planner.h"
+#include "mempool.h"
+#include "log.h"
+
+static Truck* trucks = NULL;
+static int truckTotal = 0;
+static int truckCapacity = 0;
+
+static DispatchSummary* summaries = NULL;   // one slot per truck
+static int summaryCount = 0;
+
+// Planning temporaries, rewound at the start of every plan
+static Arena scratch;
+static int scratchReady = 0;
+
+int fleetAddTruck(const Truck* truck) {
+    if (!truck || truck->capacity <= 0 || truck->speedKmph <= 0 || truck->shiftMinutes <= 0) return -1;
+    if (truckTotal == truckCapacity) {
+        int newCapacity = truckCapacity ? truckCapacity * 2 : 8;
+        Truck* grownTrucks = (Truck*)coreRealloc(trucks, newCapacity * sizeof(Truck));
+        if (!grownTrucks) return -1;
+        trucks = grownTrucks;
+        DispatchSummary* grownSummaries = (DispatchSummary*)coreRealloc(summaries, newCapacity * sizeof(DispatchSummary));
+        if (!grownSummaries) return -1;
+        summaries = grownSummaries;
+        truckCapacity = newCapacity;
+    }
+    trucks[truckTotal] = *truck;
+    return truckTotal++;
+}
+
+int fleetSize(void) {
+    return truckTotal;
+}
+
+const Truck* fleetTruck(int index) {
+    if (index < 0 || index >= truckTotal) return NULL;
+    return &trucks[index];
+}
+
+void fleetAddDefaultTrucks(void) {
+    for (int i = 0; i < DEFAULT_FLEET_TRUCKS; i++) {
+        Truck truck = {0};
+        truck.id = truckTotal + 1;
+        truck.capacity = DEFAULT_TRUCK_CAPACITY;
+        truck.speedKmph = DEFAULT_TRUCK_SPEED_KMPH;
+        truck.shiftMinutes = DEFAULT_TRUCK_SHIFT_MINUTES;
+        truck.loadMinutes = DEFAULT_TRUCK_LOAD_MINUTES;
+        fleetAddTruck(&truck);
+    }
+}
+
+void fleetClear(void) {
+    coreFree(trucks);
+    coreFree(summaries);
+    trucks = NULL;
+    summaries = NULL;
+    truckTotal = truckCapacity = summaryCount = 0;
+    if (scratchReady) {
+        arenaFree(&scratch);
+        scratchReady = 0;
+    }
+}
+
+int getDispatchSummaryCount(void) {
+    return summaryCount;
+}
+
+const DispatchSummary* getDispatchSummary(int index) {
+    if (index < 0 || index >= summaryCount) return NULL;
+    return &summaries[index];
+}
+
+const DispatchSummary* getLastDispatchSummary(void) {
+    return getDispatchSummary(0);
+}
+
+// --------------------------------------------------------------
+// PLANNING STATE
+// --------------------------------------------------------------
+// A job is one bin to empty; the jobs of a stop are chained through next.
+// Job order is service order, so a lower index is a more pressing bin.
+typedef struct Job {
+    Dustbin* bin;
+    int next;
+} Job;
+
+typedef struct TruckPlan {
+    int fillUsed;           // fill points taken on (100 per full bin)
+    int bins;
+    float estKm;            // length of some tour through every stop so far
+    int lastArea;           // stop opened last, AREA_DEPOT before the first
+    int stopCount;
+    int stopArea[MAX_DISPATCH_STOPS];
+    int stopFirstJob[MAX_DISPATCH_STOPS];
+    int stopBins[MAX_DISPATCH_STOPS];
+} TruckPlan;
+
+static float tripMinutes(const Truck* truck, float km, int bins) {
+    return km / truck->speedKmph * 60.0f + bins * truck->loadMinutes;
+}
+
+typedef struct AssignState {
+    const FleetPlanOptions* options;    // NULL: every truck, full shifts, any bin
+    const DistanceMatrix* matrix;
+    TruckPlan* plans;
+    Job* jobs;
+    int* areaTruck;         // truck with an open stop in the area, -1 if none
+    int* areaStop;
+    char* areaBlocked;
+    char* binTaken;         // by storeSlot: already on some truck's list
+} AssignState;
+
+static float truckMinutesLeft(const AssignState* st, int t) {
+    if (st->options && st->options->minutesLeft) return st->options->minutesLeft[t];
+    return trucks[t].shiftMinutes;
+}
+
+static int truckFits(const AssignState* st, int t, int fill, float extraKm) {
+    const Truck* truck = &trucks[t];
+    const TruckPlan* plan = &st->plans[t];
+    if (plan->fillUsed + fill > truck->capacity * 100.0f) return 0;
+    return tripMinutes(truck, plan->estKm + extraKm, plan->bins + 1) <= truckMinutesLeft(st, t);
+}
+
+static void addJobToStop(AssignState* st, TruckPlan* plan, int stop, int job) {
+    Job* jobs = st->jobs;
+    st->binTaken[jobs[job].bin->storeSlot] = 1;
+    // Prepend, then restore service order when the stop is driven
+    jobs[job].next = plan->stopFirstJob[stop];
+    plan->stopFirstJob[stop] = job;
+    plan->stopBins[stop]++;
+    plan->fillUsed += jobs[job].bin->fillLevel;
+    plan->bins++;
+}
+
+// Every bin is either added to the truck already working its area, or opens
+// a stop on the truck that can reach the area most cheaply. Opening a stop
+// next to any stop of a tour adds at most twice the distance to it, so
+// estKm always bounds a real tour. An area no truck can take is skipped
+// for the rest of the dispatch, since trucks only fill up from here.
+
+static void assignJob(AssignState* st, int job) {
+    Dustbin* bin = st->jobs[job].bin;
+    int areaId = bin->areaId;
+    int fill = bin->fillLevel;
+    if (st->areaBlocked[areaId]) return;
+
+    int open = st->areaTruck[areaId];
+    if (open >= 0) {
+        if (truckFits(st, open, fill, 0.0f)) {
+            addJobToStop(st, &st->plans[open], st->areaStop[areaId], job);
+            return;
+        }
+        st->areaTruck[areaId] = -1;
+    }
+
+    int best = -1;
+    float bestKm = 0;
+    const unsigned char* available = st->options ? st->options->available : NULL;
+    for (int t = 0; t < truckTotal; t++) {
+        const TruckPlan* plan = &st->plans[t];
+        if (plan->stopCount == MAX_DISPATCH_STOPS) continue;
+        if (available && !available[t]) continue;
+        float km = areaKmFromPoint(trucks[t].depotX, trucks[t].depotY, areaId);
+        if (plan->lastArea != AREA_DEPOT) {
+            float fromLast = distanceMatrixLegKm(st->matrix, plan->lastArea, areaId);
+            if (fromLast < km) km = fromLast;
+        }
+        km *= 2.0f;
+        if (best >= 0 && km >= bestKm) continue;
+        if (!truckFits(st, t, fill, km)) continue;
+        best = t;
+        bestKm = km;
+    }
+    if (best < 0) {
+        st->areaBlocked[areaId] = 1;
+        return;
+    }
+
+    TruckPlan* plan = &st->plans[best];
+    int stop = plan->stopCount++;
+    plan->stopArea[stop] = areaId;
+    plan->stopFirstJob[stop] = -1;
+    plan->stopBins[stop] = 0;
+    plan->estKm += bestKm;
+    plan->lastArea = areaId;
+    st->areaTruck[areaId] = best;
+    st->areaStop[areaId] = stop;
+    addJobToStop(st, plan, stop, job);
+}
+
+static int wantsBin(const AssignState* st, const Dustbin* bin) {
+    if (bin->fillLevel == 0) return 0;
+    return !st->options || !st->options->accept || st->options->accept(bin, st->options->userData);
+}
+
+// Urgent bins in pop order, then the normal queue nearest first
+static int gatherJobs(const AssignState* st, Job** out) {
+    int urgent = priorityQueueSize();
+    int capacity = urgent + queueSize();
+    Job* jobs = (Job*)arenaAlloc(&scratch, (capacity + 1) * sizeof(Job));
+    Dustbin** urgentBins = (Dustbin**)arenaAlloc(&scratch, (urgent + 1) * sizeof(Dustbin*));
+    if (!jobs || !urgentBins) return -1;
+
+    int count = 0;
+    urgent = priorityQueueSnapshot(urgentBins, urgent);
+    for (int i = 0; i < urgent; i++) {
+        if (!wantsBin(st, urgentBins[i])) continue;
+        jobs[count].bin = urgentBins[i];
+        jobs[count++].next = -1;
+    }
+    for (Dustbin* bin = queueFront(); bin; bin = queueNextByDistance(bin)) {
+        if (!wantsBin(st, bin)) continue;
+        jobs[count].bin = bin;
+        jobs[count++].next = -1;
+    }
+    *out = jobs;
+    return count;
+}
+
+static float tourKm(const Truck* truck, const int* areas, int count) {
+    if (count == 0) return 0.0f;
+    float km = areaKmFromPoint(truck->depotX, truck->depotY, areas[0]);
+    const DistanceMatrix* matrix = distanceMatrixCurrent();
+    for (int i = 1; i < count; i++) km += distanceMatrixLegKm(matrix, areas[i - 1], areas[i]);
+    return km + areaKmFromPoint(truck->depotX, truck->depotY, areas[count - 1]);
+}
+
+static int stopOfArea(const TruckPlan* plan, int areaId) {
+    for (int s = 0; s < plan->stopCount; s++) {
+        if (plan->stopArea[s] == areaId) return s;
+    }
+    return -1;
+}
+
+// Reverses a stop's job chain so bins are emptied in service order
+static int reverseChain(Job* jobs, int first) {
+    int reversed = -1;
+    while (first >= 0) {
+        int next = jobs[first].next;
+        jobs[first].next = reversed;
+        reversed = first;
+        first = next;
+    }
+    return reversed;
+}
+
+// --------------------------------------------------------------
+// PLANNING
+// --------------------------------------------------------------
+// Orders the truck's stops, drops stops from the end of the tour while the
+// real tour runs past the truck's time limit, and writes what is left as a
+// trip, appending its bins to bins. Returns 0 if nothing was left.
+static int buildTrip(int t, AssignState* st, long budgetMicros, TruckTrip* trip, Dustbin** bins, int* binTotal) {
+    const Truck* truck = &trucks[t];
+    TruckPlan* plan = &st->plans[t];
+    Job* jobs = st->jobs;
+    int route[MAX_DISPATCH_STOPS];
+    RouteResult planned;
+    if (!planRouteFrom(truck->depotX, truck->depotY, plan->stopArea, plan->stopCount,
+                       budgetMicros, route, &planned)) {
+        memcpy(route, plan->stopArea, plan->stopCount * sizeof(int));
+    }
+
+    int stops = plan->stopCount;
+    float limit = truckMinutesLeft(st, t);
+    float km = tourKm(truck, route, stops);
+    int tripBins = plan->bins;
+    int fill = plan->fillUsed;
+    while (stops > 0 && tripMinutes(truck, km, tripBins) > limit) {
+        int dropped = stopOfArea(plan, route[--stops]);
+        tripBins -= plan->stopBins[dropped];
+        for (int j = plan->stopFirstJob[dropped]; j >= 0; j = jobs[j].next) {
+            st->binTaken[jobs[j].bin->storeSlot] = 0;
+            fill -= jobs[j].bin->fillLevel;
+        }
+        km = tourKm(truck, route, stops);
+    }
+    if (stops == 0) return 0;
+
+    const DistanceMatrix* matrix = distanceMatrixCurrent();
+    trip->truck = t;
+    trip->stopCount = stops;
+    trip->km = km;
+    trip->fill = fill;
+    trip->minutesLeft = limit;
+    trip->leadBin = -1;
+    int leadJob = -1;
+    for (int s = 0; s < stops; s++) {
+        trip->stopArea[s] = route[s];
+        trip->legKm[s] = s == 0 ? areaKmFromPoint(truck->depotX, truck->depotY, route[0])
+                                : distanceMatrixLegKm(matrix, route[s - 1], route[s]);
+        trip->firstBin[s] = *binTotal;
+        int stop = stopOfArea(plan, route[s]);
+        for (int j = reverseChain(jobs, plan->stopFirstJob[stop]); j >= 0; j = jobs[j].next) {
+            if (leadJob < 0 || j < leadJob) {
+                leadJob = j;
+                trip->leadBin = *binTotal;
+            }
+            bins[(*binTotal)++] = jobs[j].bin;
+        }
+    }
+    trip->legKm[stops] = areaKmFromPoint(truck->depotX, truck->depotY, route[stops - 1]);
+    trip->firstBin[stops] = *binTotal;
+    return 1;
+}
+
+int planFleetTrips(long budgetMicros, const FleetPlanOptions* options, FleetPlan* out) {
+    out->trips = NULL;
+    out->tripCount = 0;
+    out->bins = NULL;
+    out->binTaken = NULL;
+    if (truckTotal == 0) return 0;
+    if (!scratchReady) {
+        arenaInit(&scratch, 64 * 1024);
+        scratchReady = 1;
+    }
+    arenaReset(&scratch);
+
+    AssignState st;
+    st.options = options;
+    Job* jobs = NULL;
+    int jobCount = gatherJobs(&st, &jobs);
+    int areas = areaCount();
+    st.matrix = distanceMatrixCurrent();
+    st.jobs = jobs;
+    st.plans = (TruckPlan*)arenaAlloc(&scratch, truckTotal * sizeof(TruckPlan));
+    st.areaTruck = (int*)arenaAlloc(&scratch, (areas + 1) * sizeof(int));
+    st.areaStop = (int*)arenaAlloc(&scratch, (areas + 1) * sizeof(int));
+    st.areaBlocked = (char*)arenaAlloc(&scratch, areas + 1);
+    st.binTaken = (char*)arenaAlloc(&scratch, binCount() + 1);
+    TruckTrip* trips = (TruckTrip*)arenaAlloc(&scratch, truckTotal * sizeof(TruckTrip));
+    Dustbin** bins = (Dustbin**)arenaAlloc(&scratch, (jobCount + 1) * sizeof(Dustbin*));
+    if (jobCount < 0 || !st.plans || !st.areaTruck || !st.areaStop || !st.areaBlocked || !st.binTaken ||
+        !trips || !bins) {
+        LOG_ERROR("Memory allocation error (fleet dispatch)!\n");
+        return 0;
+    }
+
+    for (int t = 0; t < truckTotal; t++) {
+        st.plans[t].fillUsed = 0;
+        st.plans[t].bins = 0;
+        st.plans[t].estKm = 0.0f;
+        st.plans[t].lastArea = AREA_DEPOT;
+        st.plans[t].stopCount = 0;
+    }
+    for (int a = 0; a < areas; a++) st.areaTruck[a] = -1;
+    memset(st.areaBlocked, 0, areas);
+    memset(st.binTaken, 0, binCount());
+
+    for (int j = 0; j < jobCount; j++) assignJob(&st, j);
+
+    // Trucks with a tour worth improving share the budget
+    int busy = 0;
+    for (int t = 0; t < truckTotal; t++) {
+        if (st.plans[t].stopCount > 2) busy++;
+    }
+    long perTruck = busy ? budgetMicros / busy : 0;
+    if (budgetMicros > 0 && perTruck == 0) perTruck = 1;
+
+    int tripCount = 0;
+    int binTotal = 0;
+    for (int t = 0; t < truckTotal; t++) {
+        if (st.plans[t].stopCount == 0) continue;
+        if (buildTrip(t, &st, perTruck, &trips[tripCount], bins, &binTotal)) tripCount++;
+    }
+    out->trips = trips;
+    out->tripCount = tripCount;
+    out->bins = bins;
+    out->binTaken = st.binTaken;
+    return tripCount;
+}
+
+// --------------------------------------------------------------
+// DISPATCH
+// --------------------------------------------------------------
+// Nearby pickups: after its own bins at a stop, a truck with room and time
+// left also empties well-filled bins of other areas close to the stop,
+// driving out and back for each
+#define NEARBY_RADIUS_KM 1.0f
+#define NEARBY_MIN_FILL 70
+#define NEARBY_MAX_PER_STOP 16
+
+typedef struct NearbyFilter {
+    const char* binTaken;
+    int areaId;
+} NearbyFilter;
+
+static int acceptNearby(const Dustbin* bin, void* userData) {
+    const NearbyFilter* f = (const NearbyFilter*)userData;
+    return bin->fillLevel >= NEARBY_MIN_FILL && bin->areaId != f->areaId && !f->binTaken[bin->storeSlot];
+}
+
+// Trip totals while a truck drives its tour
+typedef struct Trip {
+    float km;
+    int bins;
+    int fill;
+} Trip;
+
+// The detours share the trip's time limit, so a truck comes back when the
+// planner expected it to at the latest
+static int pickUpNearby(const Truck* truck, char* binTaken, float minutesLeft, int areaId, Trip* trip) {
+    float cx, cy;
+    float depotKm = areaDistance(areaId);
+    areaPointAt(areaId, depotKm > 0 ? depotKm : 0.0f, 0.0f, &cx, &cy);
+
+    Dustbin* near[NEARBY_MAX_PER_STOP];
+    float nearKm[NEARBY_MAX_PER_STOP];
+    NearbyFilter filter = {binTaken, areaId};
+    int found = findNearestBins(cx, cy, NEARBY_MAX_PER_STOP, NEARBY_RADIUS_KM, acceptNearby, &filter,
+                                near, nearKm);
+
+    int picked = 0;
+    for (int i = 0; i < found; i++) {
+        Dustbin* bin = near[i];
+        if (trip->fill + bin->fillLevel > truck->capacity * 100.0f) continue;
+        float detourKm = 2.0f * nearKm[i];
+        if (tripMinutes(truck, trip->km + detourKm, trip->bins + 1) > minutesLeft) break;
+        trip->km += detourKm;
+        trip->bins++;
+        trip->fill += bin->fillLevel;
+        binTaken[bin->storeSlot] = 1;
+        LOG_DEBUG("    Truck %d: Bin #%d in '%s' (Fill %d%%, %.2f km off route) - COLLECTED\n",
+                  truck->id, bin->binID, bin->area, bin->fillLevel, nearKm[i]);
+        markBinCollectedAndRequeue(bin->binID);
+        picked++;
+    }
+    return picked;
+}
+
+// Drives a trip of plan straight away and fills in summary
+static void driveTrip(const FleetPlan* plan, const TruckTrip* planned, DispatchSummary* summary) {
+    const Truck* truck = &trucks[planned->truck];
+    int stops = planned->stopCount;
+    Trip trip = {planned->km, planned->firstBin[stops] - planned->firstBin[0], planned->fill};
+
+    memset(summary, 0, sizeof(*summary));
+    summary->truckID = truck->id;
+    for (int s = 0; s < stops; s++) {
+        int collected = 0;
+        for (int i = planned->firstBin[s]; i < planned->firstBin[s + 1]; i++) {
+            Dustbin* bin = plan->bins[i];
+            if (bin->fillLevel == 0) continue;
+            if (i == planned->leadBin) {
+                summary->targetID = bin->binID;
+                snprintf(summary->area, sizeof(summary->area), "%s", bin->area);
+                summary->distance = bin->distance;
+                summary->startFill = bin->fillLevel;
+                summary->wasPriority = bin->fillLevel >= 90;
+            }
+            LOG_DEBUG("    Truck %d: Bin #%d (Fill %d%%) - COLLECTED\n", truck->id, bin->binID, bin->fillLevel);
+            markBinCollectedAndRequeue(bin->binID);
+            collected++;
+        }
+        int nearby = pickUpNearby(truck, plan->binTaken, planned->minutesLeft, planned->stopArea[s], &trip);
+        snprintf(summary->stops[s], sizeof(summary->stops[s]), "%s", areaName(planned->stopArea[s]));
+        summary->stopBins[s] = collected + nearby;
+        summary->binsCollected += collected + nearby;
+        summary->nearbyCollected += nearby;
+    }
+
+    summary->valid = 1;
+    summary->stopCount = stops;
+    summary->totalKm = trip.km;
+    summary->travelMinutes = trip.km / truck->speedKmph * 60.0f;
+    summary->loadMinutes = summary->binsCollected * truck->loadMinutes;
+    summary->totalTimeMinutes = summary->travelMinutes + summary->loadMinutes;
+
+    LOG_INFO("Truck %d: %d stops, %d bins (%d nearby), %.1f km, %.1f min (first: Bin #%d in '%s')\n",
+             truck->id, stops, summary->binsCollected, summary->nearbyCollected, summary->totalKm,
+             summary->totalTimeMinutes, summary->targetID, summary->area);
+    for (int s = 0; s < stops; s++) {
+        LOG_DEBUG("    Stop %d: '%s' - %d bins\n", s + 1, summary->stops[s], summary->stopBins[s]);
+    }
+}
+
+int dispatchFleet(long budgetMicros) {
+    summaryCount = 0;
+    FleetPlan plan;
+    planFleetTrips(budgetMicros, NULL, &plan);
+    for (int i = 0; i < plan.tripCount; i++) {
+        driveTrip(&plan, &plan.trips[i], &summaries[summaryCount++]);
+    }
+    return summaryCount;
+}
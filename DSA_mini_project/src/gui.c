@@ -1,5 +1,7 @@
 #include <gtk/gtk.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include "gui.h"
 
@@ -9,31 +11,36 @@ GtkWidget *priority_table;
 GtkWidget *normal_table;
 GtkWidget *status_label;
 GtkWidget *analytics_area;
+GtkWidget *main_window;
 GtkWidget *analytics_info_label;
 GtkWidget *truck_anim_area;
 GtkWidget *event_log_view;
 
 static GtkTextBuffer *event_log_buffer = NULL;
-static double truck_anim_progress = 0.0;
-static guint  truck_anim_timeout_id = 0;
-static gboolean dark_mode_enabled = FALSE;
+// Trucks currently driving across the simulator canvas. One tick callback
+// advances all of them from the frame clock; the road is drawn once into
+// truck_road_layer and blitted, so each truck only costs its own shapes.
+#define MAX_ANIMATED_TRUCKS 8
+#define TRUCK_TRIP_USEC     3000000     // one trip across the canvas
+static gint64 truck_start_times[MAX_ANIMATED_TRUCKS];
+static int    truck_count = 0;
+static double truck_idle_progress = 0.0;   // parked truck when none is moving
+static guint  truck_tick_id = 0;
+static cairo_surface_t *truck_road_layer = NULL;
+static int    truck_road_width = 0;
+static int    truck_road_height = 0;
+gboolean dark_mode_enabled = FALSE;
 static GtkCssProvider *css_provider = NULL;
 static gboolean css_provider_installed = FALSE;
-static int analytics_selected_index = -1;
-static int analytics_counts[4] = {0};
 
-static GtkWidget* create_bins_table();
 static GtkWidget* create_queue_tables();
 static GtkWidget* create_dashboard_tab();
 static GtkWidget* create_simulator_tab();
 static GtkWidget* create_analytics_tab();
 static void       load_app_css(void);
 static gboolean   on_truck_anim_draw(GtkWidget *widget, cairo_t *cr, gpointer data);
-static gboolean   truck_anim_tick(gpointer data);
+static gboolean   truck_anim_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer data);
 static gboolean   on_dark_mode_switch(GtkSwitch *widget, GParamSpec *pspec, gpointer data);
-static gboolean   on_analytics_button_press(GtkWidget *widget, GdkEventButton *event, gpointer data);
-static void       recompute_analytics_counts(void);
-static void       update_analytics_info_label(void);
 
 // --------------------------------------------------------------
 // MAIN GUI START
@@ -52,6 +59,7 @@ void start_gui(int *argc, char ***argv) {
     load_app_css();
 
     GtkWidget *window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
+    main_window = window;
     gtk_window_set_default_size(GTK_WINDOW(window), 1100, 720);
 
     // Client-side decorated header bar for a modern look
@@ -201,7 +209,19 @@ static GtkWidget* create_dashboard_tab() {
     return root;
 }
 
-static GtkWidget* create_bins_table() {
+// Fixed column widths and row heights let a view size itself without
+// measuring every row, so only the rows on screen are ever read
+static void use_fixed_row_height(GtkWidget *view) {
+    static const int widths[] = { 70, 130, 90, 70, 90 };
+    for (int i = 0; i < 5; i++) {
+        GtkTreeViewColumn *column = gtk_tree_view_get_column(GTK_TREE_VIEW(view), i);
+        gtk_tree_view_column_set_sizing(column, GTK_TREE_VIEW_COLUMN_FIXED);
+        gtk_tree_view_column_set_fixed_width(column, widths[i]);
+    }
+    gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(view), TRUE);
+}
+
+GtkWidget* create_bins_table() {
     bin_table = gtk_tree_view_new();
 
     GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
@@ -221,8 +241,13 @@ static GtkWidget* create_bins_table() {
     gtk_tree_view_insert_column_with_attributes(GTK_TREE_VIEW(bin_table), -1,
         "Status", renderer, "text", 4, NULL);
 
+    use_fixed_row_height(bin_table);
     gtk_widget_set_name(bin_table, "bins-treeview");
 
+    // Make rows clickable for inline editing
+    g_signal_connect(bin_table, "row-activated",
+                     G_CALLBACK(on_bin_row_activated), NULL);
+
     // Put tree view inside a scrolled window for better UX
     GtkWidget *scrolled = gtk_scrolled_window_new(NULL, NULL);
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolled),
@@ -270,6 +295,9 @@ static GtkWidget* create_queue_tables() {
     gtk_tree_view_insert_column_with_attributes(GTK_TREE_VIEW(normal_table), -1,
         "Status", renderer, "text", 4, NULL);
 
+    use_fixed_row_height(priority_table);
+    use_fixed_row_height(normal_table);
+
     // Wrap both tables in scrolled windows
     GtkWidget *prio_scrolled = gtk_scrolled_window_new(NULL, NULL);
     gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(prio_scrolled),
@@ -337,9 +365,7 @@ static GtkWidget* create_simulator_tab() {
     return box;
 }
 
-// Simple analytics tab with bar chart for fill level distribution
-gboolean on_analytics_draw(GtkWidget *widget, cairo_t *cr, gpointer data);
-
+// Analytics tab: chart drawing and hit-testing live in gui_analytics.c
 static GtkWidget* create_analytics_tab() {
     GtkWidget *box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
     gtk_container_set_border_width(GTK_CONTAINER(box), 15);
@@ -350,10 +376,19 @@ static GtkWidget* create_analytics_tab() {
     gtk_widget_set_halign(heading, GTK_ALIGN_START);
 
     GtkWidget *desc = gtk_label_new(
-        "Bar chart showing the count of bins in each fill-level band.\n"
+        "Fill levels across the fleet: by category, in 10% bands, per area, or over time.\n"
         "Actions on the dashboard will automatically update this chart.");
     gtk_widget_set_halign(desc, GTK_ALIGN_START);
 
+    GtkWidget *view_combo = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(view_combo), "Fill categories");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(view_combo), "10% fill bands");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(view_combo), "Bins per area");
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(view_combo), "History");
+    gtk_combo_box_set_active(GTK_COMBO_BOX(view_combo), ANALYTICS_CATEGORIES);
+    g_signal_connect(view_combo, "changed", G_CALLBACK(on_analytics_view_changed), NULL);
+    gtk_widget_set_halign(view_combo, GTK_ALIGN_START);
+
     analytics_info_label = gtk_label_new("Click a bar to view details.");
     gtk_widget_set_halign(analytics_info_label, GTK_ALIGN_START);
 
@@ -365,6 +400,7 @@ static GtkWidget* create_analytics_tab() {
 
     gtk_box_pack_start(GTK_BOX(box), heading, FALSE, FALSE, 5);
     gtk_box_pack_start(GTK_BOX(box), desc, FALSE, FALSE, 5);
+    gtk_box_pack_start(GTK_BOX(box), view_combo, FALSE, FALSE, 5);
     gtk_box_pack_start(GTK_BOX(box), analytics_info_label, FALSE, FALSE, 5);
     gtk_box_pack_start(GTK_BOX(box), analytics_area, TRUE, TRUE, 10);
 
@@ -374,36 +410,58 @@ static GtkWidget* create_analytics_tab() {
 // --------------------------------------------------------------
 // Truck dispatch animation helpers
 // --------------------------------------------------------------
+static gint64 truck_anim_now(void) {
+    GdkFrameClock *clock = gtk_widget_get_frame_clock(truck_anim_area);
+    return clock ? gdk_frame_clock_get_frame_time(clock) : g_get_monotonic_time();
+}
+
+static double truck_progress(gint64 start, gint64 now) {
+    double t = (double)(now - start) / TRUCK_TRIP_USEC;
+    return t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+}
+
 void trigger_truck_animation() {
     if (!truck_anim_area)
         return;
 
-    truck_anim_progress = 0.0;
-    if (truck_anim_timeout_id) {
-        g_source_remove(truck_anim_timeout_id);
+    // Each dispatch adds a truck; when all slots are busy the oldest,
+    // nearly finished one gives way
+    if (truck_count == MAX_ANIMATED_TRUCKS) {
+        memmove(truck_start_times, truck_start_times + 1, (MAX_ANIMATED_TRUCKS - 1) * sizeof(gint64));
+        truck_count--;
+    }
+    truck_start_times[truck_count++] = truck_anim_now();
+    if (!truck_tick_id) {
+        truck_tick_id = gtk_widget_add_tick_callback(truck_anim_area, truck_anim_tick, NULL, NULL);
     }
-    truck_anim_timeout_id = g_timeout_add(30, truck_anim_tick, NULL);
     gtk_widget_queue_draw(truck_anim_area);
 }
 
-static gboolean truck_anim_tick(gpointer data) {
+static gboolean truck_anim_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer data) {
     (void)data;
-    truck_anim_progress += 0.01;
-    if (truck_anim_progress >= 1.0) {
-        truck_anim_progress = 1.0;
-        truck_anim_timeout_id = 0;
-        gtk_widget_queue_draw(truck_anim_area);
+    gint64 now = gdk_frame_clock_get_frame_time(clock);
+
+    // Trucks finish in the order they started
+    int finished = 0;
+    while (finished < truck_count && truck_progress(truck_start_times[finished], now) >= 1.0) {
+        finished++;
+    }
+    if (finished) {
+        memmove(truck_start_times, truck_start_times + finished, (truck_count - finished) * sizeof(gint64));
+        truck_count -= finished;
+        truck_idle_progress = 1.0;
+    }
+    gtk_widget_queue_draw(widget);
+
+    if (truck_count == 0) {
+        truck_tick_id = 0;
         return G_SOURCE_REMOVE;
     }
-    gtk_widget_queue_draw(truck_anim_area);
     return G_SOURCE_CONTINUE;
 }
 
-static gboolean on_truck_anim_draw(GtkWidget *widget, cairo_t *cr, gpointer data) {
-    (void)data;
-    double width = gtk_widget_get_allocated_width(widget);
-    double height = gtk_widget_get_allocated_height(widget);
-
+// Background, road and divider: redrawn only when the canvas is resized
+static void paint_truck_road(cairo_t *cr, double width, double height) {
     // Background
     cairo_set_source_rgb(cr, 0.94, 0.96, 0.99);
     cairo_paint(cr);
@@ -422,13 +480,25 @@ static gboolean on_truck_anim_draw(GtkWidget *widget, cairo_t *cr, gpointer data
     cairo_set_dash(cr, (double[]){10.0, 6.0}, 2, 0);
     cairo_stroke(cr);
     cairo_set_dash(cr, NULL, 0, 0);
+}
 
-    // Calculate truck position
-    double start_x = 30;
-    double end_x = width - 110;
-    double truck_x = start_x + (end_x - start_x) * truck_anim_progress;
-    double truck_y = road_y - 10;
+static cairo_surface_t* truck_road_surface(GtkWidget *widget, int width, int height) {
+    if (truck_road_layer && truck_road_width == width && truck_road_height == height) {
+        return truck_road_layer;
+    }
+    if (truck_road_layer) cairo_surface_destroy(truck_road_layer);
+    truck_road_layer = gdk_window_create_similar_surface(gtk_widget_get_window(widget),
+                                                         CAIRO_CONTENT_COLOR, width, height);
+    truck_road_width = width;
+    truck_road_height = height;
+
+    cairo_t *layer = cairo_create(truck_road_layer);
+    paint_truck_road(layer, width, height);
+    cairo_destroy(layer);
+    return truck_road_layer;
+}
 
+static void draw_truck(cairo_t *cr, double truck_x, double truck_y) {
     // Truck body
     cairo_set_source_rgb(cr, 0.2, 0.45, 0.9);
     cairo_rectangle(cr, truck_x, truck_y - 20, 70, 30);
@@ -444,21 +514,122 @@ static gboolean on_truck_anim_draw(GtkWidget *widget, cairo_t *cr, gpointer data
     cairo_arc(cr, truck_x + 15, truck_y + 10, 8, 0, 2 * G_PI);
     cairo_arc(cr, truck_x + 55, truck_y + 10, 8, 0, 2 * G_PI);
     cairo_fill(cr);
+}
+
+static gboolean on_truck_anim_draw(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    (void)data;
+    int width = gtk_widget_get_allocated_width(widget);
+    int height = gtk_widget_get_allocated_height(widget);
+
+    cairo_set_source_surface(cr, truck_road_surface(widget, width, height), 0, 0);
+    cairo_paint(cr);
+
+    // Truck positions, interpolated from the frame time
+    double start_x = 30;
+    double end_x = width - 110;
+    double truck_y = height * 0.65 - 10;
+    gint64 now = truck_anim_now();
+    double newest = truck_idle_progress;
+    if (truck_count == 0) {
+        draw_truck(cr, start_x + (end_x - start_x) * truck_idle_progress, truck_y);
+    }
+    for (int i = 0; i < truck_count; i++) {
+        newest = truck_progress(truck_start_times[i], now);
+        draw_truck(cr, start_x + (end_x - start_x) * newest, truck_y);
+    }
 
     // Progress text
     cairo_set_source_rgb(cr, 0.2, 0.2, 0.3);
     cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD);
     cairo_set_font_size(cr, 12);
     char buf[64];
-    snprintf(buf, sizeof(buf), "Dispatch progress: %d%%", (int)(truck_anim_progress * 100));
+    if (truck_count > 1) {
+        snprintf(buf, sizeof(buf), "Dispatch progress: %d%% (%d trucks en route)",
+                 (int)(newest * 100), truck_count);
+    } else {
+        snprintf(buf, sizeof(buf), "Dispatch progress: %d%%", (int)(newest * 100));
+    }
     cairo_move_to(cr, 30, 30);
     cairo_show_text(cr, buf);
 
     return FALSE;
 }
 
+// --------------------------------------------------------------
+// Event log: bounded, batched, optionally mirrored to disk
+// --------------------------------------------------------------
+// Messages are timestamped into a pending ring and flushed to the text
+// buffer by the refresh scheduler, so a burst costs one insert and one
+// scroll per frame. The buffer keeps at most event_log_capacity lines and
+// drops the oldest beyond that; if more than that many arrive within one
+// frame, the oldest pending ones are dropped too.
+static int      event_log_capacity = EVENT_LOG_DEFAULT_LINES;
+static int      event_log_lines = 0;            // lines in the text buffer
+static gchar  **event_log_pending = NULL;       // ring of event_log_capacity lines
+static int      event_log_pending_start = 0;
+static int      event_log_pending_count = 0;
+static GtkTextMark *event_log_end_mark = NULL;  // follows the end of the buffer
+
+static FILE    *event_log_file = NULL;
+static gchar   *event_log_path = NULL;
+static long     event_log_file_bytes = 0;
+static long     event_log_max_bytes = 0;
+static int      event_log_max_files = 0;
+
+static void open_event_log_file(void) {
+    event_log_file = fopen(event_log_path, "a");
+    event_log_file_bytes = 0;
+    if (event_log_file && fseek(event_log_file, 0, SEEK_END) == 0) {
+        event_log_file_bytes = ftell(event_log_file);
+    }
+}
+
+// path -> path.1 -> path.2 ... oldest beyond max_files is overwritten
+static void rotate_event_log_file(void) {
+    fclose(event_log_file);
+    for (int i = event_log_max_files - 1; i >= 1; i--) {
+        gchar *from = i == 1 ? g_strdup(event_log_path) : g_strdup_printf("%s.%d", event_log_path, i - 1);
+        gchar *to = g_strdup_printf("%s.%d", event_log_path, i);
+        rename(from, to);
+        g_free(from);
+        g_free(to);
+    }
+    if (event_log_max_files < 2) remove(event_log_path);
+    open_event_log_file();
+}
+
+static void mirror_event_log_line(const char *line) {
+    if (!event_log_file) return;
+    if (event_log_max_bytes > 0 && event_log_file_bytes >= event_log_max_bytes) {
+        rotate_event_log_file();
+        if (!event_log_file) return;
+    }
+    size_t len = strlen(line);
+    fwrite(line, 1, len, event_log_file);
+    event_log_file_bytes += (long)len;
+}
+
+void configure_event_log(int max_lines, const char *mirror_path, long max_file_bytes, int max_files) {
+    flush_event_log();
+    for (int i = 0; i < event_log_pending_count; i++) {
+        g_free(event_log_pending[(event_log_pending_start + i) % event_log_capacity]);
+    }
+    g_free(event_log_pending);
+    event_log_pending = NULL;
+    event_log_pending_start = event_log_pending_count = 0;
+    event_log_capacity = max_lines > 0 ? max_lines : EVENT_LOG_DEFAULT_LINES;
+
+    if (event_log_file) fclose(event_log_file);
+    event_log_file = NULL;
+    g_free(event_log_path);
+    event_log_path = mirror_path ? g_strdup(mirror_path) : NULL;
+    event_log_max_bytes = max_file_bytes;
+    event_log_max_files = max_files;
+    if (event_log_path) open_event_log_file();
+}
+
 void append_event_log(const char *message) {
-    if (!event_log_buffer || !event_log_view || !message) return;
+    if (!message) return;
 
     time_t now = time(NULL);
     struct tm tm_now;
@@ -471,162 +642,53 @@ void append_event_log(const char *message) {
     strftime(timebuf, sizeof(timebuf), "%H:%M:%S", &tm_now);
 
     gchar *formatted = g_strdup_printf("[%s] %s\n", timebuf, message);
-
-    GtkTextIter end;
-    gtk_text_buffer_get_end_iter(event_log_buffer, &end);
-    gtk_text_buffer_insert(event_log_buffer, &end, formatted, -1);
-
-    GtkTextMark *mark = gtk_text_buffer_create_mark(event_log_buffer, NULL, &end, FALSE);
-    gtk_text_view_scroll_mark_onscreen(GTK_TEXT_VIEW(event_log_view), mark);
-    gtk_text_buffer_delete_mark(event_log_buffer, mark);
-
-    g_free(formatted);
-}
-
-// --------------------------------------------------------------
-// Analytics helpers & drawing
-// --------------------------------------------------------------
-static void recompute_analytics_counts(void) {
-    analytics_counts[0] = analytics_counts[1] = analytics_counts[2] = analytics_counts[3] = 0;
-
-    Dustbin *cur = head;
-    while (cur) {
-        if (cur->fillLevel >= 90) analytics_counts[0]++;
-        else if (cur->fillLevel >= 70) analytics_counts[1]++;
-        else if (cur->fillLevel >= 50) analytics_counts[2]++;
-        else analytics_counts[3]++;
-        cur = cur->next;
-    }
-}
-
-static const char *analytics_labels[4] = { "URGENT (≥ 90%)", "HIGH (70–89%)", "MEDIUM (50–69%)", "LOW (< 50%)" };
-
-static void update_analytics_info_label(void) {
-    if (!analytics_info_label) return;
-
-    if (analytics_selected_index < 0) {
-        gtk_label_set_text(GTK_LABEL(analytics_info_label), "Click a bar to view category details.");
-        return;
-    }
-
-    int count = analytics_counts[analytics_selected_index];
-    gchar *text = g_strdup_printf("%s: %d bins", analytics_labels[analytics_selected_index], count);
-    gtk_label_set_text(GTK_LABEL(analytics_info_label), text);
-    g_free(text);
-}
-
-void refresh_analytics() {
-    recompute_analytics_counts();
-    update_analytics_info_label();
-    if (analytics_area) {
-        gtk_widget_queue_draw(analytics_area);
+    mirror_event_log_line(formatted);
+
+    if (!event_log_pending) event_log_pending = g_new0(gchar *, event_log_capacity);
+    if (event_log_pending_count == event_log_capacity) {
+        // Would be evicted from the view anyway
+        g_free(event_log_pending[event_log_pending_start]);
+        event_log_pending_start = (event_log_pending_start + 1) % event_log_capacity;
+        event_log_pending_count--;
     }
+    event_log_pending[(event_log_pending_start + event_log_pending_count) % event_log_capacity] = formatted;
+    event_log_pending_count++;
+    schedule_refresh(VIEW_EVENT_LOG);
 }
 
-gboolean on_analytics_draw(GtkWidget *widget, cairo_t *cr, gpointer data) {
-    (void)data;
-    double width  = gtk_widget_get_allocated_width(widget);
-    double height = gtk_widget_get_allocated_height(widget);
-
-    cairo_set_source_rgb(cr, dark_mode_enabled ? 0.16 : 0.97,
-                             dark_mode_enabled ? 0.18 : 0.98,
-                             dark_mode_enabled ? 0.22 : 1.0);
-    cairo_paint(cr);
-
-    double margin = 40.0;
-    double chart_w = width - 2 * margin;
-    double chart_h = height - 2 * margin;
-    if (chart_w <= 0 || chart_h <= 0) return FALSE;
-
-    cairo_set_source_rgb(cr, dark_mode_enabled ? 0.85 : 0.2,
-                             dark_mode_enabled ? 0.85 : 0.2,
-                             dark_mode_enabled ? 0.9 : 0.3);
-    cairo_set_line_width(cr, 1.0);
-    cairo_move_to(cr, margin, margin);
-    cairo_line_to(cr, margin, margin + chart_h);
-    cairo_line_to(cr, margin + chart_w, margin + chart_h);
-    cairo_stroke(cr);
+void flush_event_log(void) {
+    if (event_log_file) fflush(event_log_file);
+    if (!event_log_pending_count || !event_log_buffer) return;
 
-    int max = 1;
-    for (int i = 0; i < 4; ++i) {
-        if (analytics_counts[i] > max) max = analytics_counts[i];
+    GString *batch = g_string_new(NULL);
+    for (int i = 0; i < event_log_pending_count; i++) {
+        gchar **slot = &event_log_pending[(event_log_pending_start + i) % event_log_capacity];
+        g_string_append(batch, *slot);
+        g_free(*slot);
+        *slot = NULL;
     }
+    int added = event_log_pending_count;
+    event_log_pending_start = event_log_pending_count = 0;
 
-    double spacing = chart_w / 4.0;
-    double bar_w = spacing * 0.45;
-
-    for (int i = 0; i < 4; ++i) {
-        double cx = margin + spacing * (i + 0.5);
-        double bar_h = (max > 0) ? (chart_h * analytics_counts[i] / (double)max) : 0.0;
-        double x = cx - bar_w / 2.0;
-        double y = margin + chart_h - bar_h;
-
-        if (i == 0)      cairo_set_source_rgb(cr, 0.85, 0.15, 0.15);
-        else if (i == 1) cairo_set_source_rgb(cr, 0.95, 0.6, 0.0);
-        else if (i == 2) cairo_set_source_rgb(cr, 0.4, 0.7, 0.2);
-        else             cairo_set_source_rgb(cr, 0.2, 0.5, 0.9);
-
-        if (analytics_selected_index == i) {
-            cairo_save(cr);
-            cairo_rectangle(cr, x - 2, y - 2, bar_w + 4, bar_h + 4);
-            cairo_set_source_rgba(cr, 1, 1, 1, 0.15);
-            cairo_fill(cr);
-            cairo_restore(cr);
-        }
-
-        cairo_rectangle(cr, x, y, bar_w, bar_h);
-        cairo_fill(cr);
-
-        cairo_set_source_rgb(cr, dark_mode_enabled ? 0.9 : 0.1,
-                                 dark_mode_enabled ? 0.9 : 0.1,
-                                 dark_mode_enabled ? 0.95 : 0.2);
-        cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
-        cairo_set_font_size(cr, 10.0);
-        cairo_move_to(cr, cx - 30, margin + chart_h + 15);
-        cairo_show_text(cr, analytics_labels[i]);
-
-        char numbuf[16];
-        snprintf(numbuf, sizeof(numbuf), "%d", analytics_counts[i]);
-        cairo_move_to(cr, cx - 5, y - 5);
-        cairo_show_text(cr, numbuf);
+    GtkTextIter start, end;
+    gtk_text_buffer_get_end_iter(event_log_buffer, &end);
+    gtk_text_buffer_insert(event_log_buffer, &end, batch->str, (int)batch->len);
+    g_string_free(batch, TRUE);
+
+    event_log_lines += added;
+    if (event_log_lines > event_log_capacity) {
+        GtkTextIter cut;
+        gtk_text_buffer_get_start_iter(event_log_buffer, &start);
+        gtk_text_buffer_get_iter_at_line(event_log_buffer, &cut, event_log_lines - event_log_capacity);
+        gtk_text_buffer_delete(event_log_buffer, &start, &cut);
+        event_log_lines = event_log_capacity;
     }
 
-    return FALSE;
-}
-
-static gboolean on_analytics_button_press(GtkWidget *widget, GdkEventButton *event, gpointer data) {
-    (void)data;
-    if (event->button != GDK_BUTTON_PRIMARY) return FALSE;
-
-    double width  = gtk_widget_get_allocated_width(widget);
-    double height = gtk_widget_get_allocated_height(widget);
-    double margin = 40.0;
-    double chart_w = width - 2 * margin;
-    double chart_h = height - 2 * margin;
-    if (chart_w <= 0 || chart_h <= 0) return FALSE;
-
-    int max = 1;
-    for (int i = 0; i < 4; ++i) if (analytics_counts[i] > max) max = analytics_counts[i];
-    double spacing = chart_w / 4.0;
-    double bar_w = spacing * 0.45;
-    double chart_bottom = margin + chart_h;
-
-    for (int i = 0; i < 4; ++i) {
-        double cx = margin + spacing * (i + 0.5);
-        double bar_h = (max > 0) ? (chart_h * analytics_counts[i] / (double)max) : 0.0;
-        double x = cx - bar_w / 2.0;
-        double y = chart_bottom - bar_h;
-
-        if (event->x >= x && event->x <= x + bar_w &&
-            event->y >= y && event->y <= chart_bottom) {
-            analytics_selected_index = i;
-            update_analytics_info_label();
-            gtk_widget_queue_draw(widget);
-            return TRUE;
-        }
+    if (!event_log_end_mark) {
+        gtk_text_buffer_get_end_iter(event_log_buffer, &end);
+        event_log_end_mark = gtk_text_buffer_create_mark(event_log_buffer, "log-end", &end, FALSE);
     }
-
-    return FALSE;
+    gtk_text_view_scroll_mark_onscreen(GTK_TEXT_VIEW(event_log_view), event_log_end_mark);
 }
 
 static gboolean on_dark_mode_switch(GtkSwitch *widget, GParamSpec *pspec, gpointer data) {
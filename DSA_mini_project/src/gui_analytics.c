@@ -0,0 +1,343 @@
+#include "gui.h"
+#include <stdio.h>
+#include <string.h>
+
+// --------------------------------------------------------------
+// ANALYTICS CHART
+// --------------------------------------------------------------
+// The chart keeps three layers of cached state:
+//   data   - values read from the core, refreshed only when the fleet
+//            version moves (or the view changes)
+//   layout - bar rectangles for the current size, rebuilt only when the
+//            data or the allocation changes
+//   pixels - drawn from the cached layout on expose
+// Clicks are hit-tested against the cached rectangles.
+
+#define MAX_CHART_BARS  32
+#define HISTORY_POINTS  120
+#define CHART_MARGIN    40.0
+
+typedef struct ChartBar {
+    double x, y, w, h;          // layout, in widget coordinates
+    int value;
+    double r, g, b;
+    char label[24];             // under the bar
+    char detail[80];            // shown in the info label when selected
+} ChartBar;
+
+static struct {
+    AnalyticsView view;
+    gboolean have_data;         // bars match the current view and version
+    unsigned long data_version; // fleet version of the newest history sample
+    int bar_count;
+    int max_value;
+    ChartBar bars[MAX_CHART_BARS];
+
+    // One FillSummary per fleet version seen, oldest first (ring)
+    FillSummary history[HISTORY_POINTS];
+    int history_start;
+    int history_count;
+
+    gboolean layout_valid;
+    int layout_width;
+    int layout_height;
+    double plot_w;              // chart area inside the margins
+    double plot_h;
+
+    int selected;
+} chart = { .view = ANALYTICS_CATEGORIES, .selected = -1 };
+
+static const char *category_labels[4] = { "URGENT (≥ 90%)", "HIGH (70–89%)", "MEDIUM (50–69%)", "LOW (< 50%)" };
+static const double category_colors[4][3] = {
+    { 0.85, 0.15, 0.15 }, { 0.95, 0.6, 0.0 }, { 0.4, 0.7, 0.2 }, { 0.2, 0.5, 0.9 }
+};
+
+static ChartBar* add_bar(int value, const double color[3]) {
+    if (chart.bar_count == MAX_CHART_BARS) return NULL;
+    ChartBar *bar = &chart.bars[chart.bar_count++];
+    bar->value = value;
+    bar->r = color[0];
+    bar->g = color[1];
+    bar->b = color[2];
+    bar->label[0] = bar->detail[0] = '\0';
+    if (value > chart.max_value) chart.max_value = value;
+    return bar;
+}
+
+// Fill-band colour for a bucket or average: same thresholds as the categories
+static const double* fill_color(double fill) {
+    if (fill >= 90) return category_colors[0];
+    if (fill >= 70) return category_colors[1];
+    if (fill >= 50) return category_colors[2];
+    return category_colors[3];
+}
+
+static void collect_categories(void) {
+    FillSummary s;
+    getFillSummary(&s);
+    int counts[4] = { s.urgent, s.high, s.medium, s.low };
+    for (int i = 0; i < 4; i++) {
+        ChartBar *bar = add_bar(counts[i], category_colors[i]);
+        snprintf(bar->label, sizeof(bar->label), "%s", category_labels[i]);
+        snprintf(bar->detail, sizeof(bar->detail), "%s: %d bins", category_labels[i], counts[i]);
+    }
+}
+
+static void collect_fill_buckets(void) {
+    int buckets[FILL_BUCKETS];
+    getFillHistogram(buckets);
+    for (int i = 0; i < FILL_BUCKETS; i++) {
+        int low = i * 10, high = i == FILL_BUCKETS - 1 ? 100 : low + 9;
+        ChartBar *bar = add_bar(buckets[i], fill_color(low));
+        snprintf(bar->label, sizeof(bar->label), "%d%%", low);
+        snprintf(bar->detail, sizeof(bar->detail), "%d–%d%% full: %d bins", low, high, buckets[i]);
+    }
+}
+
+static void collect_areas(void) {
+    AreaFillStats stats[MAX_CHART_BARS];
+    int n = getAreaFillStats(stats, MAX_CHART_BARS);
+    for (int i = 0; i < n; i++) {
+        ChartBar *bar = add_bar(stats[i].bins, fill_color(stats[i].averageFill));
+        snprintf(bar->label, sizeof(bar->label), "%.10s", stats[i].area);
+        snprintf(bar->detail, sizeof(bar->detail), "%s: %d bins, %d urgent, %.0f%% average fill",
+                 stats[i].area, stats[i].bins, stats[i].urgent, stats[i].averageFill);
+    }
+}
+
+// History is drawn as lines, but each sample still gets a (full-height)
+// column so clicks can pick one
+static void collect_history(void) {
+    for (int i = 0; i < chart.history_count; i++) {
+        const FillSummary *s = &chart.history[(chart.history_start + i) % HISTORY_POINTS];
+        if (s->total > chart.max_value) chart.max_value = s->total;
+    }
+}
+
+static void record_history(void) {
+    FillSummary s;
+    getFillSummary(&s);
+    if (chart.history_count == HISTORY_POINTS) {
+        chart.history_start = (chart.history_start + 1) % HISTORY_POINTS;
+        chart.history_count--;
+    }
+    chart.history[(chart.history_start + chart.history_count++) % HISTORY_POINTS] = s;
+}
+
+static void collect_chart_data(void) {
+    chart.bar_count = 0;
+    chart.max_value = 1;
+    switch (chart.view) {
+        case ANALYTICS_CATEGORIES:  collect_categories(); break;
+        case ANALYTICS_FILL_BUCKETS: collect_fill_buckets(); break;
+        case ANALYTICS_AREAS:       collect_areas(); break;
+        case ANALYTICS_HISTORY:     collect_history(); break;
+    }
+    if (chart.view != ANALYTICS_HISTORY && chart.selected >= chart.bar_count) chart.selected = -1;
+    chart.layout_valid = FALSE;
+}
+
+static int history_columns(void) {
+    return chart.history_count > 1 ? chart.history_count : 1;
+}
+
+static void ensure_layout(int width, int height) {
+    if (chart.layout_valid && chart.layout_width == width && chart.layout_height == height) return;
+    chart.layout_valid = TRUE;
+    chart.layout_width = width;
+    chart.layout_height = height;
+    chart.plot_w = width - 2 * CHART_MARGIN;
+    chart.plot_h = height - 2 * CHART_MARGIN;
+    if (chart.plot_w <= 0 || chart.plot_h <= 0 || chart.view == ANALYTICS_HISTORY) return;
+
+    double spacing = chart.plot_w / chart.bar_count;
+    double bar_w = spacing * 0.45;
+    double bottom = CHART_MARGIN + chart.plot_h;
+    for (int i = 0; i < chart.bar_count; i++) {
+        ChartBar *bar = &chart.bars[i];
+        bar->h = chart.plot_h * bar->value / (double)chart.max_value;
+        bar->w = bar_w;
+        bar->x = CHART_MARGIN + spacing * (i + 0.5) - bar_w / 2.0;
+        bar->y = bottom - bar->h;
+    }
+}
+
+static void update_analytics_info_label(void) {
+    if (!analytics_info_label) return;
+
+    if (chart.selected < 0) {
+        gtk_label_set_text(GTK_LABEL(analytics_info_label),
+                           chart.view == ANALYTICS_HISTORY ? "Click the chart to inspect a sample."
+                                                           : "Click a bar to view category details.");
+        return;
+    }
+
+    if (chart.view == ANALYTICS_HISTORY) {
+        const FillSummary *s = &chart.history[(chart.history_start + chart.selected) % HISTORY_POINTS];
+        gchar *text = g_strdup_printf("Sample %d of %d: %d bins, %d urgent, %d high, %d medium, %d low",
+                                      chart.selected + 1, chart.history_count,
+                                      s->total, s->urgent, s->high, s->medium, s->low);
+        gtk_label_set_text(GTK_LABEL(analytics_info_label), text);
+        g_free(text);
+        return;
+    }
+    gtk_label_set_text(GTK_LABEL(analytics_info_label), chart.bars[chart.selected].detail);
+}
+
+// Called with the core readable (startup or the refresh scheduler)
+void refresh_analytics() {
+    unsigned long version = getFleetVersion();
+    gboolean changed = chart.history_count == 0 || version != chart.data_version;
+    if (!changed && chart.have_data) return;
+
+    if (changed) {
+        record_history();
+        chart.data_version = version;
+    }
+    chart.have_data = TRUE;
+    collect_chart_data();
+    update_analytics_info_label();
+    if (analytics_area) {
+        gtk_widget_queue_draw(analytics_area);
+    }
+}
+
+void set_analytics_view(AnalyticsView view) {
+    if (view == chart.view) return;
+    chart.view = view;
+    chart.selected = -1;
+    // Collect on the next scheduled refresh, when the core is readable
+    chart.have_data = FALSE;
+    schedule_refresh(VIEW_ANALYTICS);
+}
+
+void on_analytics_view_changed(GtkComboBox *combo, gpointer data) {
+    (void)data;
+    int active = gtk_combo_box_get_active(combo);
+    if (active >= 0) set_analytics_view((AnalyticsView)active);
+}
+
+static void set_text_color(cairo_t *cr) {
+    cairo_set_source_rgb(cr, dark_mode_enabled ? 0.9 : 0.1,
+                             dark_mode_enabled ? 0.9 : 0.1,
+                             dark_mode_enabled ? 0.95 : 0.2);
+}
+
+static void draw_bars(cairo_t *cr) {
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 10.0);
+    double bottom = CHART_MARGIN + chart.plot_h;
+    for (int i = 0; i < chart.bar_count; ++i) {
+        const ChartBar *bar = &chart.bars[i];
+        if (chart.selected == i) {
+            cairo_save(cr);
+            cairo_rectangle(cr, bar->x - 2, bar->y - 2, bar->w + 4, bar->h + 4);
+            cairo_set_source_rgba(cr, 1, 1, 1, 0.15);
+            cairo_fill(cr);
+            cairo_restore(cr);
+        }
+
+        cairo_set_source_rgb(cr, bar->r, bar->g, bar->b);
+        cairo_rectangle(cr, bar->x, bar->y, bar->w, bar->h);
+        cairo_fill(cr);
+
+        set_text_color(cr);
+        double cx = bar->x + bar->w / 2.0;
+        double label_offset = chart.bar_count <= 4 ? 30 : 3.0 * strlen(bar->label);
+        cairo_move_to(cr, cx - label_offset, bottom + 15);
+        cairo_show_text(cr, bar->label);
+
+        char numbuf[16];
+        snprintf(numbuf, sizeof(numbuf), "%d", bar->value);
+        cairo_move_to(cr, cx - 5, bar->y - 5);
+        cairo_show_text(cr, numbuf);
+    }
+}
+
+// Urgent and total bins across the recorded samples
+static void draw_history(cairo_t *cr) {
+    double bottom = CHART_MARGIN + chart.plot_h;
+    double step = chart.plot_w / history_columns();
+    for (int series = 0; series < 2; series++) {
+        if (series == 0) cairo_set_source_rgb(cr, 0.2, 0.5, 0.9);
+        else             cairo_set_source_rgb(cr, 0.85, 0.15, 0.15);
+        cairo_set_line_width(cr, 2.0);
+        for (int i = 0; i < chart.history_count; i++) {
+            const FillSummary *s = &chart.history[(chart.history_start + i) % HISTORY_POINTS];
+            int value = series == 0 ? s->total : s->urgent;
+            double x = CHART_MARGIN + step * (i + 0.5);
+            double y = bottom - chart.plot_h * value / (double)chart.max_value;
+            if (i == 0) cairo_move_to(cr, x, y);
+            else        cairo_line_to(cr, x, y);
+        }
+        cairo_stroke(cr);
+    }
+
+    if (chart.selected >= 0 && chart.selected < chart.history_count) {
+        double x = CHART_MARGIN + step * (chart.selected + 0.5);
+        cairo_set_source_rgba(cr, 0.5, 0.5, 0.5, 0.6);
+        cairo_set_line_width(cr, 1.0);
+        cairo_move_to(cr, x, CHART_MARGIN);
+        cairo_line_to(cr, x, bottom);
+        cairo_stroke(cr);
+    }
+
+    set_text_color(cr);
+    cairo_select_font_face(cr, "Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, 10.0);
+    cairo_move_to(cr, CHART_MARGIN, bottom + 15);
+    cairo_show_text(cr, "Total bins (blue) and urgent bins (red) per change, oldest on the left");
+}
+
+gboolean on_analytics_draw(GtkWidget *widget, cairo_t *cr, gpointer data) {
+    (void)data;
+    ensure_layout(gtk_widget_get_allocated_width(widget), gtk_widget_get_allocated_height(widget));
+
+    cairo_set_source_rgb(cr, dark_mode_enabled ? 0.16 : 0.97,
+                             dark_mode_enabled ? 0.18 : 0.98,
+                             dark_mode_enabled ? 0.22 : 1.0);
+    cairo_paint(cr);
+    if (chart.plot_w <= 0 || chart.plot_h <= 0 || !chart.have_data) return FALSE;
+
+    cairo_set_source_rgb(cr, dark_mode_enabled ? 0.85 : 0.2,
+                             dark_mode_enabled ? 0.85 : 0.2,
+                             dark_mode_enabled ? 0.9 : 0.3);
+    cairo_set_line_width(cr, 1.0);
+    cairo_move_to(cr, CHART_MARGIN, CHART_MARGIN);
+    cairo_line_to(cr, CHART_MARGIN, CHART_MARGIN + chart.plot_h);
+    cairo_line_to(cr, CHART_MARGIN + chart.plot_w, CHART_MARGIN + chart.plot_h);
+    cairo_stroke(cr);
+
+    if (chart.view == ANALYTICS_HISTORY) draw_history(cr);
+    else                                 draw_bars(cr);
+    return FALSE;
+}
+
+gboolean on_analytics_button_press(GtkWidget *widget, GdkEventButton *event, gpointer data) {
+    (void)data;
+    if (event->button != GDK_BUTTON_PRIMARY || !chart.have_data) return FALSE;
+    ensure_layout(gtk_widget_get_allocated_width(widget), gtk_widget_get_allocated_height(widget));
+    if (chart.plot_w <= 0 || chart.plot_h <= 0) return FALSE;
+
+    int hit = -1;
+    double bottom = CHART_MARGIN + chart.plot_h;
+    if (chart.view == ANALYTICS_HISTORY) {
+        int column = (int)((event->x - CHART_MARGIN) / (chart.plot_w / history_columns()));
+        if (event->x >= CHART_MARGIN && column < chart.history_count && event->y <= bottom) hit = column;
+    } else {
+        for (int i = 0; i < chart.bar_count; ++i) {
+            const ChartBar *bar = &chart.bars[i];
+            if (event->x >= bar->x && event->x <= bar->x + bar->w &&
+                event->y >= bar->y && event->y <= bottom) {
+                hit = i;
+                break;
+            }
+        }
+    }
+    if (hit < 0) return FALSE;
+
+    chart.selected = hit;
+    update_analytics_info_label();
+    gtk_widget_queue_draw(widget);
+    return TRUE;
+}
@@ -0,0 +1,332 @@
+#include "gui_bin_model.h"
+
+struct _BinTreeModel {
+    GObject parent_instance;
+    BinModelKind kind;
+    gint stamp;
+    int row_count;          // rows the views have been told about
+    gboolean stale;         // rows were recounted rather than followed; wants a resync pass
+    Dustbin **snapshot;     // BIN_MODEL_PRIORITY: bins in dispatch order
+};
+
+static void bin_tree_model_iface_init(GtkTreeModelIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(BinTreeModel, bin_tree_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, bin_tree_model_iface_init))
+
+// --------------------------------------------------------------
+// ROW LOOKUP
+// --------------------------------------------------------------
+static int live_row_count(const BinTreeModel *m) {
+    switch (m->kind) {
+        case BIN_MODEL_ALL:      return binCount();
+        case BIN_MODEL_PRIORITY: return priorityQueueSize();
+        case BIN_MODEL_NORMAL:   return queueSize();
+    }
+    return 0;
+}
+
+// row_count always matches the core (or is 0 while frozen), so every row a
+// view can ask about has a bin behind it
+static const Dustbin* row_bin(const BinTreeModel *m, int row) {
+    if (row < 0 || row >= m->row_count) return NULL;
+    switch (m->kind) {
+        case BIN_MODEL_ALL:      return binAt(row);
+        case BIN_MODEL_PRIORITY: return m->snapshot[row];
+        case BIN_MODEL_NORMAL:   return queueBinAt(row);
+    }
+    return NULL;
+}
+
+static const char* row_status(const BinTreeModel *m, const Dustbin *bin) {
+    if (m->kind == BIN_MODEL_PRIORITY) return "URGENT";
+    if (m->kind == BIN_MODEL_NORMAL) return "NORMAL";
+    // Same thresholds as the console
+    if (bin->fillLevel >= 90) return "URGENT";
+    if (bin->fillLevel >= 70) return "HIGH";
+    if (bin->fillLevel >= 50) return "MEDIUM";
+    return "LOW";
+}
+
+static void set_iter(BinTreeModel *m, GtkTreeIter *iter, int row) {
+    iter->stamp = m->stamp;
+    iter->user_data = GINT_TO_POINTER(row);
+    iter->user_data2 = NULL;
+    iter->user_data3 = NULL;
+}
+
+static int iter_row(const GtkTreeIter *iter) {
+    return GPOINTER_TO_INT(iter->user_data);
+}
+
+// --------------------------------------------------------------
+// GtkTreeModel INTERFACE
+// --------------------------------------------------------------
+static GtkTreeModelFlags bin_model_get_flags(GtkTreeModel *model) {
+    return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint bin_model_get_n_columns(GtkTreeModel *model) {
+    return BIN_N_COLUMNS;
+}
+
+static GType bin_model_get_column_type(GtkTreeModel *model, gint column) {
+    return G_TYPE_STRING;
+}
+
+static gboolean bin_model_get_iter(GtkTreeModel *model, GtkTreeIter *iter, GtkTreePath *path) {
+    BinTreeModel *m = BIN_TREE_MODEL(model);
+    if (gtk_tree_path_get_depth(path) != 1) return FALSE;
+    int row = gtk_tree_path_get_indices(path)[0];
+    if (row < 0 || row >= m->row_count) return FALSE;
+    set_iter(m, iter, row);
+    return TRUE;
+}
+
+static GtkTreePath* bin_model_get_path(GtkTreeModel *model, GtkTreeIter *iter) {
+    return gtk_tree_path_new_from_indices(iter_row(iter), -1);
+}
+
+// Cell text is built here, so only rows a view actually draws cost anything
+static void bin_model_get_value(GtkTreeModel *model, GtkTreeIter *iter, gint column, GValue *value) {
+    BinTreeModel *m = BIN_TREE_MODEL(model);
+    g_value_init(value, G_TYPE_STRING);
+    const Dustbin *bin = row_bin(m, iter_row(iter));
+    if (!bin) {
+        g_value_set_static_string(value, "");
+        return;
+    }
+    switch (column) {
+        case BIN_COL_ID:
+            g_value_take_string(value, g_strdup_printf("%d", bin->binID));
+            break;
+        case BIN_COL_AREA:
+            g_value_set_string(value, bin->area);
+            break;
+        case BIN_COL_DISTANCE:
+            g_value_take_string(value, g_strdup_printf("%.2f", bin->distance));
+            break;
+        case BIN_COL_FILL:
+            g_value_take_string(value, g_strdup_printf("%d", bin->fillLevel));
+            break;
+        case BIN_COL_STATUS:
+            g_value_set_static_string(value, row_status(m, bin));
+            break;
+    }
+}
+
+static gboolean bin_model_iter_next(GtkTreeModel *model, GtkTreeIter *iter) {
+    BinTreeModel *m = BIN_TREE_MODEL(model);
+    int row = iter_row(iter) + 1;
+    if (row >= m->row_count) return FALSE;
+    set_iter(m, iter, row);
+    return TRUE;
+}
+
+static gboolean bin_model_iter_previous(GtkTreeModel *model, GtkTreeIter *iter) {
+    BinTreeModel *m = BIN_TREE_MODEL(model);
+    int row = iter_row(iter) - 1;
+    if (row < 0) return FALSE;
+    set_iter(m, iter, row);
+    return TRUE;
+}
+
+static gboolean bin_model_iter_nth_child(GtkTreeModel *model, GtkTreeIter *iter,
+                                         GtkTreeIter *parent, gint n) {
+    BinTreeModel *m = BIN_TREE_MODEL(model);
+    if (parent || n < 0 || n >= m->row_count) return FALSE;
+    set_iter(m, iter, n);
+    return TRUE;
+}
+
+static gboolean bin_model_iter_children(GtkTreeModel *model, GtkTreeIter *iter, GtkTreeIter *parent) {
+    return bin_model_iter_nth_child(model, iter, parent, 0);
+}
+
+static gboolean bin_model_iter_has_child(GtkTreeModel *model, GtkTreeIter *iter) {
+    return FALSE;
+}
+
+static gint bin_model_iter_n_children(GtkTreeModel *model, GtkTreeIter *iter) {
+    return iter ? 0 : BIN_TREE_MODEL(model)->row_count;
+}
+
+static gboolean bin_model_iter_parent(GtkTreeModel *model, GtkTreeIter *iter, GtkTreeIter *child) {
+    return FALSE;
+}
+
+static void bin_tree_model_iface_init(GtkTreeModelIface *iface) {
+    iface->get_flags = bin_model_get_flags;
+    iface->get_n_columns = bin_model_get_n_columns;
+    iface->get_column_type = bin_model_get_column_type;
+    iface->get_iter = bin_model_get_iter;
+    iface->get_path = bin_model_get_path;
+    iface->get_value = bin_model_get_value;
+    iface->iter_next = bin_model_iter_next;
+    iface->iter_previous = bin_model_iter_previous;
+    iface->iter_children = bin_model_iter_children;
+    iface->iter_has_child = bin_model_iter_has_child;
+    iface->iter_n_children = bin_model_iter_n_children;
+    iface->iter_nth_child = bin_model_iter_nth_child;
+    iface->iter_parent = bin_model_iter_parent;
+}
+
+// --------------------------------------------------------------
+// OBJECT LIFECYCLE
+// --------------------------------------------------------------
+static void bin_tree_model_finalize(GObject *object) {
+    BinTreeModel *m = BIN_TREE_MODEL(object);
+    g_free(m->snapshot);
+    G_OBJECT_CLASS(bin_tree_model_parent_class)->finalize(object);
+}
+
+static void bin_tree_model_class_init(BinTreeModelClass *klass) {
+    G_OBJECT_CLASS(klass)->finalize = bin_tree_model_finalize;
+}
+
+static void bin_tree_model_init(BinTreeModel *m) {
+    m->stamp = g_random_int();
+}
+
+BinTreeModel* bin_tree_model_new(BinModelKind kind) {
+    BinTreeModel *m = g_object_new(BIN_TYPE_TREE_MODEL, NULL);
+    m->kind = kind;
+    bin_tree_model_resync(m);
+    return m;
+}
+
+// --------------------------------------------------------------
+// CHANGE TRACKING
+// --------------------------------------------------------------
+static void emit_row_inserted(BinTreeModel *m, int row) {
+    GtkTreeIter iter;
+    m->stamp++;
+    set_iter(m, &iter, row);
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_inserted(GTK_TREE_MODEL(m), path, &iter);
+    gtk_tree_path_free(path);
+}
+
+static void emit_row_deleted(BinTreeModel *m, int row) {
+    m->stamp++;
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_deleted(GTK_TREE_MODEL(m), path);
+    gtk_tree_path_free(path);
+}
+
+static void emit_row_changed(BinTreeModel *m, int row) {
+    GtkTreeIter iter;
+    set_iter(m, &iter, row);
+    GtkTreePath *path = gtk_tree_path_new_from_indices(row, -1);
+    gtk_tree_model_row_changed(GTK_TREE_MODEL(m), path, &iter);
+    gtk_tree_path_free(path);
+}
+
+// Bin store rows: adds append, a delete moves the last row into the hole
+static gboolean apply_all_change(BinTreeModel *m, BinChange change, const Dustbin *bin, int live) {
+    switch (change) {
+        case BIN_ADDED:
+            if (live != m->row_count + 1) return FALSE;
+            m->row_count++;
+            emit_row_inserted(m, bin->storeSlot);
+            return TRUE;
+        case BIN_REMOVED: {
+            if (live != m->row_count - 1) return FALSE;
+            int vacated = bin->storeSlot;
+            m->row_count--;
+            emit_row_deleted(m, m->row_count);
+            if (vacated < m->row_count) emit_row_changed(m, vacated);
+            return TRUE;
+        }
+        case BIN_UPDATED:
+            if (live != m->row_count) return FALSE;
+            emit_row_changed(m, bin->storeSlot);
+            return TRUE;
+        default:
+            return FALSE;
+    }
+}
+
+// Normal queue rows: distance never changes, so a bin's row only appears,
+// disappears or changes in place
+static gboolean apply_normal_change(BinTreeModel *m, BinChange change, const Dustbin *bin, int live) {
+    if (change == BIN_RESET) return FALSE;
+    gboolean queued = change != BIN_REMOVED && binInNormalQueue(bin);
+    if (live == m->row_count) {
+        if (queued) emit_row_changed(m, queueIndexOf(bin));
+        return TRUE;
+    }
+    if (live == m->row_count + 1 && queued) {
+        m->row_count++;
+        emit_row_inserted(m, queueIndexOf(bin));
+        return TRUE;
+    }
+    if (live == m->row_count - 1 && !queued) {
+        m->row_count--;
+        emit_row_deleted(m, queueIndexOf(bin));
+        return TRUE;
+    }
+    return FALSE;
+}
+
+// Dispatch order depends on priority, so any change touching an urgent bin
+// re-snapshots; the urgent list is the short one
+static gboolean apply_priority_change(BinTreeModel *m, BinChange change, const Dustbin *bin, int live) {
+    if (change == BIN_RESET) return FALSE;
+    if (live != m->row_count) return FALSE;
+    return change == BIN_REMOVED || !binInPriorityQueue(bin);
+}
+
+static int take_snapshot(BinTreeModel *m) {
+    int live = priorityQueueSize();
+    g_free(m->snapshot);
+    m->snapshot = g_new(Dustbin *, live > 0 ? live : 1);
+    return priorityQueueSnapshot(m->snapshot, live);
+}
+
+// A change the rows couldn't follow one by one: delete or append rows at
+// the end until the count matches the core again, so no row is left
+// without a bin. What the surviving rows show is redrawn by the resync.
+static void recount_rows(BinTreeModel *m) {
+    int live = m->kind == BIN_MODEL_PRIORITY ? take_snapshot(m) : live_row_count(m);
+    while (m->row_count > live) {
+        m->row_count--;
+        emit_row_deleted(m, m->row_count);
+    }
+    while (m->row_count < live) {
+        m->row_count++;
+        emit_row_inserted(m, m->row_count - 1);
+    }
+    m->stale = TRUE;
+}
+
+gboolean bin_tree_model_apply_change(BinTreeModel *model, BinChange change, const Dustbin *bin) {
+    int live = live_row_count(model);
+    gboolean handled = FALSE;
+    if (!model->stale) {
+        switch (model->kind) {
+            case BIN_MODEL_ALL:      handled = apply_all_change(model, change, bin, live); break;
+            case BIN_MODEL_PRIORITY: handled = apply_priority_change(model, change, bin, live); break;
+            case BIN_MODEL_NORMAL:   handled = apply_normal_change(model, change, bin, live); break;
+        }
+    }
+    if (!handled) recount_rows(model);
+    return model->stale;
+}
+
+gboolean bin_tree_model_needs_resync(BinTreeModel *model) {
+    return model->stale;
+}
+
+void bin_tree_model_invalidate(BinTreeModel *model) {
+    model->stamp++;
+    model->row_count = 0;
+    model->stale = TRUE;
+}
+
+// Call with the model detached from its view: row counts jump here
+void bin_tree_model_resync(BinTreeModel *model) {
+    model->stamp++;
+    model->row_count = model->kind == BIN_MODEL_PRIORITY ? take_snapshot(model) : live_row_count(model);
+    model->stale = FALSE;
+}
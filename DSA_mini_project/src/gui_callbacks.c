@@ -1,24 +1,43 @@
 #include "gui.h"
+#include "fleet.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Core changes schedule their own view refreshes (see schedule_refresh),
+// so callbacks here only mutate the core. Quick edits run right here under
+// the core write lock; simulations go to the worker thread (gui_worker.c).
+
 // Selected Bin ID (for edit/delete)
 static int selected_bin_id = -1;
 
+// Edits wait until a running simulation has finished with the core
+static gboolean core_busy(void) {
+    if (!core_job_running()) return FALSE;
+    append_event_log("Busy: a simulation is still running.");
+    return TRUE;
+}
+
 // --------------------------------------------------------------
 // ROW ACTIVATED: Edit Bin Inline
 // --------------------------------------------------------------
 void on_bin_row_activated(GtkTreeView *tree_view, GtkTreePath *path,
                           GtkTreeViewColumn *column, gpointer user_data) {
 
+    if (core_busy()) return;
+
     GtkTreeModel *model = gtk_tree_view_get_model(tree_view);
     GtkTreeIter iter;
 
-    if (gtk_tree_model_get_iter(model, &iter, path)) {
-        gchar *id_str;
+    if (model && gtk_tree_model_get_iter(model, &iter, path)) {
+        gchar *id_str = NULL;
         gtk_tree_model_get(model, &iter, 0, &id_str, -1);
-        selected_bin_id = atoi(id_str);
+        // Only a row with a real bin ID behind it opens the editor
+        char *end = NULL;
+        long id = id_str ? strtol(id_str, &end, 10) : 0;
+        gboolean valid = id_str && end != id_str && *end == '\0';
         g_free(id_str);
+        if (!valid) return;
+        selected_bin_id = (int)id;
 
         // Ask for new fill level via GTK dialog
         GtkWidget *dialog = gtk_dialog_new_with_buttons(
@@ -41,12 +60,11 @@ void on_bin_row_activated(GtkTreeView *tree_view, GtkTreePath *path,
         if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_OK) {
             const char *text = gtk_entry_get_text(GTK_ENTRY(entry));
             int new_fill = atoi(text);
-            updateFillLevel(selected_bin_id, new_fill);
-            refresh_bin_table();
-            refresh_priority_queue();
-            refresh_normal_queue();
-            refresh_system_status();
-            refresh_analytics();
+            if (!core_busy()) {
+                coreWriteLock();
+                updateFillLevel(selected_bin_id, new_fill);
+                coreWriteUnlock();
+            }
         }
 
         gtk_widget_destroy(dialog);
@@ -106,14 +124,11 @@ void on_add_bin_clicked(GtkButton *button, gpointer user_data) {
         int   fill  = atoi(fill_txt);
 
         // Basic validation; backend will also validate
-        if (strlen(area_txt) > 0) {
+        if (strlen(area_txt) > 0 && !core_busy()) {
+            coreWriteLock();
             addBin(id, (char*)area_txt, dist, fill);
             queueBinsByDistance();
-            refresh_bin_table();
-            refresh_priority_queue();
-            refresh_normal_queue();
-            refresh_system_status();
-            refresh_analytics();
+            coreWriteUnlock();
         }
     }
 
@@ -147,18 +162,15 @@ void on_delete_bin_clicked(GtkButton *button, gpointer user_data) {
 
     gint response = gtk_dialog_run(GTK_DIALOG(dialog));
     gtk_widget_destroy(dialog);
-    if (response != GTK_RESPONSE_ACCEPT) {
+    if (response != GTK_RESPONSE_ACCEPT || core_busy()) {
         return;
     }
 
+    coreWriteLock();
     deleteBin(selected_bin_id);
-    selected_bin_id = -1;
     queueBinsByDistance();
-    refresh_bin_table();
-    refresh_priority_queue();
-    refresh_normal_queue();
-    refresh_system_status();
-    refresh_analytics();
+    coreWriteUnlock();
+    selected_bin_id = -1;
 }
 
 void on_update_bin_clicked(GtkButton *button, gpointer user_data) {
@@ -170,7 +182,7 @@ void on_update_bin_clicked(GtkButton *button, gpointer user_data) {
     }
 }
 
-void on_init_random_clicked(GtkButton *button, gpointer user_data) {
+static void reinitialize_bins_job(gpointer data) {
     // Reinitialize the full system of bins
     clearQueue();
     clearPriorityQueue();
@@ -178,49 +190,68 @@ void on_init_random_clicked(GtkButton *button, gpointer user_data) {
     freeAreaDistances();
     initializeRandomBins();
     queueBinsByDistance();
-    refresh_bin_table();
-    refresh_priority_queue();
-    refresh_normal_queue();
-    refresh_system_status();
-    refresh_analytics();
 }
 
-void on_fill_time_clicked(GtkButton *button, gpointer user_data) {
+static void fill_time_job(gpointer data) {
     simulateFillLevelIncrease();
     queueBinsByDistance();
-    refresh_bin_table();
-    refresh_priority_queue();
-    refresh_normal_queue();
-    refresh_system_status();
-    refresh_analytics();
 }
 
-void on_sort_bins_clicked(GtkButton *button, gpointer user_data) {
+static void sort_bins_job(gpointer data) {
     queueBinsByDistance();
-    refresh_bin_table();
-    refresh_priority_queue();
-    refresh_normal_queue();
-    refresh_analytics();
 }
 
-void on_truck_collect_clicked(GtkButton *button, gpointer user_data) {
+static void truck_collect_job(gpointer data) {
     simulateTruckCollection();
-    refresh_bin_table();
-    refresh_priority_queue();
-    refresh_normal_queue();
-    refresh_system_status();
-    refresh_analytics();
+}
+
+static void truck_collect_done(gpointer data) {
+    int trucks = getDispatchSummaryCount();
+    if (trucks == 0) {
+        append_event_log("No bins required dispatch.");
+        return;
+    }
     trigger_truck_animation();
-    const DispatchSummary *summary = getLastDispatchSummary();
-    if (summary) {
-        gchar *msg = g_strdup_printf("Truck returned from %s (Bin #%d) • Collected %d bins in %.1f min",
-                                     summary->area,
+    for (int t = 0; t < trucks; t++) {
+        const DispatchSummary *summary = getDispatchSummary(t);
+        // Name the first few stops; long routes are summarised by count
+        GString *route = g_string_new(NULL);
+        for (int i = 0; i < summary->stopCount && i < 4; i++) {
+            if (i > 0) g_string_append(route, " → ");
+            g_string_append(route, summary->stops[i]);
+        }
+        if (summary->stopCount > 4) g_string_append_printf(route, " (+%d more)", summary->stopCount - 4);
+        gchar *msg = g_strdup_printf("Truck %d returned from %s (Bin #%d) • Collected %d bins, %.1f km in %.1f min",
+                                     summary->truckID,
+                                     route->str,
                                      summary->targetID,
                                      summary->binsCollected,
+                                     summary->totalKm,
                                      summary->totalTimeMinutes);
         append_event_log(msg);
         g_free(msg);
-    } else {
-        append_event_log("No bins required dispatch.");
+        g_string_free(route, TRUE);
+    }
+}
+
+static void start_job(CoreJobFunc job, CoreJobDone done) {
+    if (!run_core_job(job, done, NULL)) {
+        append_event_log("Busy: a simulation is still running.");
     }
 }
+
+void on_init_random_clicked(GtkButton *button, gpointer user_data) {
+    start_job(reinitialize_bins_job, NULL);
+}
+
+void on_fill_time_clicked(GtkButton *button, gpointer user_data) {
+    start_job(fill_time_job, NULL);
+}
+
+void on_sort_bins_clicked(GtkButton *button, gpointer user_data) {
+    start_job(sort_bins_job, NULL);
+}
+
+void on_truck_collect_clicked(GtkButton *button, gpointer user_data) {
+    start_job(truck_collect_job, truck_collect_done);
+}
@@ -1,132 +1,161 @@
 #include "gui.h"
+#include "gui_bin_model.h"
 #include <gtk/gtk.h>
 
 // Data comes directly from core lists/queues declared in core.h
 extern Dustbin* head;
-extern queue* front;
-extern priorityqueue* priorityfront;
 extern GtkWidget *analytics_area;
 
 // --------------------------------------------------------------
-// GENERIC TREE MODEL REFRESH FROM DUSTBIN NODES
+// LIVE BIN MODELS
 // --------------------------------------------------------------
-static void fill_tree_view_from_dustbins(GtkWidget *tree_view, Dustbin *list_head) {
-    GtkListStore *store = gtk_list_store_new(5, G_TYPE_STRING, G_TYPE_STRING,
-                                             G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
-    GtkTreeIter iter;
-
-    Dustbin *current = list_head;
-    while (current != NULL) {
-        char id_str[8], dist_str[8], fill_str[8];
-        sprintf(id_str, "%d", current->binID);
-        sprintf(dist_str, "%.2f", current->distance);
-        sprintf(fill_str, "%d", current->fillLevel);
-
-        // Derive status label from fill level (same logic as console)
-        char status[20];
-        if (current->fillLevel >= 90) sprintf(status, "URGENT");
-        else if (current->fillLevel >= 70) sprintf(status, "HIGH");
-        else if (current->fillLevel >= 50) sprintf(status, "MEDIUM");
-        else sprintf(status, "LOW");
-
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           0, id_str,
-                           1, current->area,
-                           2, dist_str,
-                           3, fill_str,
-                           4, status,
-                           -1);
-        current = current->next;
-    }
+// Each table shows a BinTreeModel that reads rows straight out of the core,
+// so the GUI keeps no copy of the fleet. Core change notifications become
+// row signals; when a change can't be expressed that way (a reset, a batch,
+// a reordered dispatch list) the table is marked stale and resynced by the
+// refresh scheduler below.
+static BinTreeModel *bin_models[3];
+
+static GtkWidget* model_view(int kind) {
+    if (kind == BIN_MODEL_ALL) return bin_table;
+    if (kind == BIN_MODEL_PRIORITY) return priority_table;
+    return normal_table;
+}
 
-    gtk_tree_view_set_model(GTK_TREE_VIEW(tree_view), GTK_TREE_MODEL(store));
-    g_object_unref(store);
+static guint model_view_flag(int kind) {
+    if (kind == BIN_MODEL_ALL) return VIEW_BIN_TABLE;
+    if (kind == BIN_MODEL_PRIORITY) return VIEW_PRIORITY_QUEUE;
+    return VIEW_NORMAL_QUEUE;
+}
 
-    // Make rows clickable for inline editing
-    g_signal_connect(tree_view, "row-activated",
-                     G_CALLBACK(on_bin_row_activated), NULL);
+static void resync_bin_model(int kind) {
+    if (!bin_models[kind] || !bin_tree_model_needs_resync(bin_models[kind])) return;
+    // Swap the model out so the view drops its rows instead of being told
+    // about every one of them
+    GtkWidget *view = model_view(kind);
+    if (view) gtk_tree_view_set_model(GTK_TREE_VIEW(view), NULL);
+    bin_tree_model_resync(bin_models[kind]);
+    if (view) gtk_tree_view_set_model(GTK_TREE_VIEW(view), GTK_TREE_MODEL(bin_models[kind]));
 }
 
 // --------------------------------------------------------------
-void refresh_bin_table() {
-    fill_tree_view_from_dustbins(bin_table, head);
+// REFRESH SCHEDULER
+// --------------------------------------------------------------
+// Stale views accumulate in dirty_views; one frame-clock tick (or an idle
+// callback before the window is realized) refreshes them all just ahead of
+// layout and paint, however many changes arrived in between.
+static guint dirty_views = 0;
+static guint refresh_source = 0;
+
+static void run_scheduled_refresh(void) {
+    refresh_source = 0;
+    if (dirty_views & VIEW_EVENT_LOG) {
+        dirty_views &= ~VIEW_EVENT_LOG;
+        flush_event_log();
+    }
+    // A worker owns the core; its completion schedules everything again
+    if (core_job_running()) return;
+    coreReadLock();
+
+    guint views = dirty_views;
+    dirty_views = 0;
+    for (int kind = 0; kind < 3; kind++) {
+        if (views & model_view_flag(kind)) resync_bin_model(kind);
+    }
+    if (views & VIEW_SYSTEM_STATUS) refresh_system_status();
+    if (views & VIEW_ANALYTICS) refresh_analytics();
+    coreReadUnlock();
 }
 
-void refresh_priority_queue() {
-    // Priority queue is already built from priority bins; iterate queue nodes
-    GtkListStore *store = gtk_list_store_new(5, G_TYPE_STRING, G_TYPE_STRING,
-                                             G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
-    GtkTreeIter iter;
-
-    priorityqueue *current = priorityfront;
-    while (current != NULL) {
-        char id_str[8], dist_str[8], fill_str[8];
-        sprintf(id_str, "%d", current->binID);
-        sprintf(dist_str, "%.2f", current->distance);
-        sprintf(fill_str, "%d", current->fillLevel);
-
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           0, id_str,
-                           1, current->area,
-                           2, dist_str,
-                           3, fill_str,
-                           4, "URGENT",
-                           -1);
-        current = current->next;
+static gboolean scheduled_refresh_tick(GtkWidget *widget, GdkFrameClock *clock, gpointer data) {
+    run_scheduled_refresh();
+    return G_SOURCE_REMOVE;
+}
+
+static gboolean scheduled_refresh_idle(gpointer data) {
+    run_scheduled_refresh();
+    return G_SOURCE_REMOVE;
+}
+
+void schedule_refresh(guint views) {
+    dirty_views |= views;
+    if (refresh_source || !dirty_views) return;
+    if (main_window && gtk_widget_get_realized(main_window)) {
+        refresh_source = gtk_widget_add_tick_callback(main_window, scheduled_refresh_tick, NULL, NULL);
+    } else {
+        refresh_source = g_idle_add_full(GDK_PRIORITY_REDRAW, scheduled_refresh_idle, NULL, NULL);
     }
+}
 
-    gtk_tree_view_set_model(GTK_TREE_VIEW(priority_table), GTK_TREE_MODEL(store));
-    g_object_unref(store);
+// The tables go empty while a worker owns the core: each view lets go of
+// its model, which then has no rows to hand out until the resync
+void freeze_live_views(void) {
+    for (int kind = 0; kind < 3; kind++) {
+        if (!bin_models[kind]) continue;
+        GtkWidget *view = model_view(kind);
+        if (view) gtk_tree_view_set_model(GTK_TREE_VIEW(view), NULL);
+        bin_tree_model_invalidate(bin_models[kind]);
+    }
+    dirty_views |= VIEW_ALL;
 }
 
-void refresh_normal_queue() {
-    GtkListStore *store = gtk_list_store_new(5, G_TYPE_STRING, G_TYPE_STRING,
-                                             G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
-    GtkTreeIter iter;
-
-    queue *current = front;
-    while (current != NULL) {
-        char id_str[8], dist_str[8], fill_str[8];
-        sprintf(id_str, "%d", current->binID);
-        sprintf(dist_str, "%.2f", current->distance);
-        sprintf(fill_str, "%d", current->fillLevel);
-
-        gtk_list_store_append(store, &iter);
-        gtk_list_store_set(store, &iter,
-                           0, id_str,
-                           1, current->area,
-                           2, dist_str,
-                           3, fill_str,
-                           4, "NORMAL",
-                           -1);
-        current = current->next;
+static void on_bin_changed(BinChange change, const Dustbin *bin, void *userData) {
+    // Changes made by a worker arrive on its thread; the tables are frozen
+    // and get resynced once the job is done
+    if (core_job_running()) return;
+
+    // Every change can move the fill counts; tables only need a pass when
+    // their rows couldn't follow the change one by one
+    guint views = VIEW_SYSTEM_STATUS | VIEW_ANALYTICS;
+    for (int kind = 0; kind < 3; kind++) {
+        if (bin_tree_model_apply_change(bin_models[kind], change, bin)) views |= model_view_flag(kind);
     }
+    schedule_refresh(views);
+}
+
+static void ensure_bin_models(void) {
+    if (bin_models[0]) return;
+    bin_models[BIN_MODEL_ALL] = bin_tree_model_new(BIN_MODEL_ALL);
+    bin_models[BIN_MODEL_PRIORITY] = bin_tree_model_new(BIN_MODEL_PRIORITY);
+    bin_models[BIN_MODEL_NORMAL] = bin_tree_model_new(BIN_MODEL_NORMAL);
+    addBinChangeListener(on_bin_changed, NULL);
+}
+
+// Attach the live model the first time; from then on the change listener
+// keeps it current and refreshing is a no-op. Columns and signals belong to
+// the view and are set up once in gui.c, never here.
+static void attach_bin_model(BinModelKind kind, GtkWidget *view) {
+    ensure_bin_models();
+    GtkTreeModel *model = GTK_TREE_MODEL(bin_models[kind]);
+    if (view && gtk_tree_view_get_model(GTK_TREE_VIEW(view)) != model) {
+        gtk_tree_view_set_model(GTK_TREE_VIEW(view), model);
+    }
+}
 
-    gtk_tree_view_set_model(GTK_TREE_VIEW(normal_table), GTK_TREE_MODEL(store));
-    g_object_unref(store);
+// --------------------------------------------------------------
+void refresh_bin_table() {
+    attach_bin_model(BIN_MODEL_ALL, bin_table);
+}
+
+void refresh_priority_queue() {
+    attach_bin_model(BIN_MODEL_PRIORITY, priority_table);
+}
+
+void refresh_normal_queue() {
+    attach_bin_model(BIN_MODEL_NORMAL, normal_table);
 }
 
 // High-level system status -> dashboard label
 void refresh_system_status() {
     if (!status_label) return;
 
-    int total = 0, urgent = 0, high = 0, medium = 0, low = 0;
-    Dustbin *cur = head;
-    while (cur) {
-        total++;
-        if (cur->fillLevel >= 90) urgent++;
-        else if (cur->fillLevel >= 70) high++;
-        else if (cur->fillLevel >= 50) medium++;
-        else low++;
-        cur = cur->next;
-    }
+    FillSummary s;
+    getFillSummary(&s);
 
     char buf[256];
     snprintf(buf, sizeof(buf),
              "Total bins: %d | Urgent: %d | High: %d | Medium: %d | Low: %d",
-             total, urgent, high, medium, low);
+             s.total, s.urgent, s.high, s.medium, s.low);
 
     gtk_label_set_text(GTK_LABEL(status_label), buf);
 }
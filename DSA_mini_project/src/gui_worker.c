@@ -0,0 +1,58 @@
+#include "gui.h"
+
+// --------------------------------------------------------------
+// BACKGROUND CORE JOBS
+// --------------------------------------------------------------
+// Long core operations (fleet initialization, simulations) run on a GTask
+// worker thread holding the core write lock, so the main loop keeps
+// drawing. While a job runs the live tables are frozen and the main thread
+// does not read the core; when it finishes, the completion callback runs
+// back on the main loop, publishes the results and schedules one refresh
+// of every view. Only one job runs at a time.
+
+typedef struct CoreJob {
+    CoreJobFunc func;
+    CoreJobDone done;
+    gpointer data;
+} CoreJob;
+
+// Written only on the main thread, and never while a worker is running
+static gboolean job_running = FALSE;
+
+gboolean core_job_running(void) {
+    return job_running;
+}
+
+static void core_job_thread(GTask *task, gpointer source, gpointer task_data, GCancellable *cancellable) {
+    CoreJob *job = task_data;
+    coreWriteLock();
+    job->func(job->data);
+    coreWriteUnlock();
+    g_task_return_boolean(task, TRUE);
+}
+
+static void core_job_finished(GObject *source, GAsyncResult *result, gpointer user_data) {
+    CoreJob *job = g_task_get_task_data(G_TASK(result));
+    job_running = FALSE;
+    if (job->done) job->done(job->data);
+    schedule_refresh(VIEW_ALL);
+}
+
+gboolean run_core_job(CoreJobFunc func, CoreJobDone done, gpointer data) {
+    if (job_running) return FALSE;
+
+    CoreJob *job = g_new(CoreJob, 1);
+    job->func = func;
+    job->done = done;
+    job->data = data;
+
+    job_running = TRUE;
+    freeze_live_views();
+    if (status_label) gtk_label_set_text(GTK_LABEL(status_label), "Working...");
+
+    GTask *task = g_task_new(NULL, NULL, core_job_finished, NULL);
+    g_task_set_task_data(task, job, g_free);
+    g_task_run_in_thread(task, core_job_thread);
+    g_object_unref(task);
+    return TRUE;
+}
@@ -0,0 +1,176 @@
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "log.h"
+
+// Bounded MPMC ring (Vyukov): each slot's sequence number says whether it is
+// free for the producer claiming position pos (seq == pos) or holds a message
+// ready for the consumer (seq == pos + 1). Only the writer thread consumes.
+typedef struct LogSlot {
+    atomic_size_t sequence;
+    char text[LOG_MESSAGE_MAX];
+} LogSlot;
+
+static LogSlot ring[LOG_RING_SIZE];
+static atomic_size_t enqueuePos;
+static atomic_size_t dequeuePos;
+static atomic_size_t writtenCount;      // messages fully written by the writer
+static atomic_ulong droppedCount;
+
+static atomic_int runtimeLevel = LOG_LEVEL_INFO;
+static atomic_int synchronous = 0;
+static _Atomic(FILE*) output = NULL;
+
+static pthread_once_t startOnce = PTHREAD_ONCE_INIT;
+static pthread_t writerThread;
+static atomic_int writerRunning = 0;
+static atomic_int stopRequested = 0;
+
+static FILE* currentOutput(void) {
+    FILE* out = atomic_load(&output);
+    return out ? out : stdout;
+}
+
+static void sleepBriefly(void) {
+    struct timespec pause = {0, 1000000};   // 1 ms
+    nanosleep(&pause, NULL);
+}
+
+// Writes every published message; returns how many it wrote
+static size_t drainRing(FILE* out) {
+    size_t pos = atomic_load_explicit(&dequeuePos, memory_order_relaxed);
+    size_t written = 0;
+    for (;;) {
+        LogSlot* slot = &ring[pos & (LOG_RING_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        if (seq != pos + 1) break;
+        fputs(slot->text, out);
+        atomic_store_explicit(&slot->sequence, pos + LOG_RING_SIZE, memory_order_release);
+        pos++;
+        written++;
+    }
+    atomic_store_explicit(&dequeuePos, pos, memory_order_relaxed);
+    return written;
+}
+
+static void* writerMain(void* arg) {
+    (void)arg;
+    unsigned long reportedDrops = 0;
+    for (;;) {
+        FILE* out = currentOutput();
+        size_t written = drainRing(out);
+        unsigned long drops = atomic_load(&droppedCount);
+        if (drops != reportedDrops) {
+            fprintf(out, "[log] %lu messages dropped (ring full)\n", drops - reportedDrops);
+            reportedDrops = drops;
+        }
+        if (written) {
+            fflush(out);
+            atomic_fetch_add(&writtenCount, written);
+            continue;
+        }
+        if (atomic_load(&stopRequested)) break;
+        sleepBriefly();
+    }
+    return NULL;
+}
+
+static void startLogging(void) {
+    for (size_t i = 0; i < LOG_RING_SIZE; i++) {
+        atomic_init(&ring[i].sequence, i);
+    }
+    if (pthread_create(&writerThread, NULL, writerMain, NULL) == 0) {
+        atomic_store(&writerRunning, 1);
+        atexit(logShutdown);
+    }
+}
+
+static void writeDirect(const char* format, va_list args) {
+    FILE* out = currentOutput();
+    vfprintf(out, format, args);
+    fflush(out);
+}
+
+void logWrite(int level, const char* format, ...) {
+    if (level < atomic_load_explicit(&runtimeLevel, memory_order_relaxed)) return;
+    pthread_once(&startOnce, startLogging);
+
+    va_list args;
+    va_start(args, format);
+    if (atomic_load_explicit(&synchronous, memory_order_relaxed) || !atomic_load(&writerRunning)) {
+        writeDirect(format, args);
+        va_end(args);
+        return;
+    }
+
+    // Claim a slot without locking; give up if the writer is a full ring behind
+    size_t pos = atomic_load_explicit(&enqueuePos, memory_order_relaxed);
+    LogSlot* slot;
+    for (;;) {
+        slot = &ring[pos & (LOG_RING_SIZE - 1)];
+        size_t seq = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueuePos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            atomic_fetch_add(&droppedCount, 1);
+            va_end(args);
+            return;
+        } else {
+            pos = atomic_load_explicit(&enqueuePos, memory_order_relaxed);
+        }
+    }
+    vsnprintf(slot->text, LOG_MESSAGE_MAX, format, args);
+    va_end(args);
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+}
+
+void logSetLevel(int level) {
+    atomic_store(&runtimeLevel, level);
+}
+
+int logLevelEnabled(int level) {
+    return level >= atomic_load_explicit(&runtimeLevel, memory_order_relaxed);
+}
+
+void logSetOutput(FILE* out) {
+    logFlush();
+    atomic_store(&output, out);
+}
+
+void logSetSynchronous(int enabled) {
+    if (enabled) logFlush();
+    atomic_store(&synchronous, enabled ? 1 : 0);
+}
+
+void logFlush(void) {
+    if (!atomic_load(&writerRunning)) return;
+    size_t target = atomic_load(&enqueuePos);
+    while (atomic_load(&writtenCount) < target) {
+        // Claimed-but-unpublished slots hold the writer back until their
+        // producer finishes formatting, so this terminates
+        sched_yield();
+    }
+}
+
+unsigned long logDroppedCount(void) {
+    return atomic_load(&droppedCount);
+}
+
+void logShutdown(void) {
+    if (!atomic_exchange(&writerRunning, 0)) return;
+    atomic_store(&stopRequested, 1);
+    pthread_join(writerThread, NULL);
+    // Anything queued after the writer's last pass
+    FILE* out = currentOutput();
+    size_t written = drainRing(out);
+    atomic_fetch_add(&writtenCount, written);
+    fflush(out);
+}
@@ -0,0 +1,176 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include "mempool.h"
+
+static AllocStats allocStats = {0};
+
+#define ALIGNMENT _Alignof(max_align_t)
+#define ALIGN_UP(n) (((n) + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1))
+
+// ----------------------------
+// Counted heap wrappers
+// ----------------------------
+void* coreMalloc(size_t size) {
+    allocStats.mallocs++;
+    return malloc(size);
+}
+
+void* coreCalloc(size_t count, size_t size) {
+    allocStats.mallocs++;
+    return calloc(count, size);
+}
+
+void* coreRealloc(void* ptr, size_t size) {
+    allocStats.reallocs++;
+    return realloc(ptr, size);
+}
+
+void coreFree(void* ptr) {
+    if (!ptr) return;
+    allocStats.frees++;
+    free(ptr);
+}
+
+const AllocStats* getAllocStats(void) {
+    return &allocStats;
+}
+
+void resetAllocStats(void) {
+    AllocStats zero = {0};
+    allocStats = zero;
+}
+
+// ----------------------------
+// Pools
+// ----------------------------
+struct PoolSlab {
+    PoolSlab* next;
+};
+
+void poolInit(Pool* pool, size_t objectSize, size_t perSlab) {
+    if (objectSize < sizeof(void*)) objectSize = sizeof(void*);
+    pool->objectSize = ALIGN_UP(objectSize);
+    pool->perSlab = perSlab ? perSlab : 256;
+    pool->freeList = NULL;
+    pool->slabs = NULL;
+    pool->inUse = 0;
+}
+
+static char* slabObjects(PoolSlab* slab) {
+    return (char*)slab + ALIGN_UP(sizeof(PoolSlab));
+}
+
+static void threadSlab(Pool* pool, PoolSlab* slab) {
+    char* objects = slabObjects(slab);
+    for (size_t i = pool->perSlab; i-- > 0;) {
+        void* object = objects + i * pool->objectSize;
+        *(void**)object = pool->freeList;
+        pool->freeList = object;
+    }
+}
+
+void* poolAlloc(Pool* pool) {
+    if (!pool->freeList) {
+        PoolSlab* slab = (PoolSlab*)coreMalloc(ALIGN_UP(sizeof(PoolSlab)) + pool->perSlab * pool->objectSize);
+        if (!slab) return NULL;
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        threadSlab(pool, slab);
+    }
+    void* object = pool->freeList;
+    pool->freeList = *(void**)object;
+    pool->inUse++;
+    allocStats.poolAllocs++;
+    return object;
+}
+
+void poolFree(Pool* pool, void* object) {
+    if (!object) return;
+    *(void**)object = pool->freeList;
+    pool->freeList = object;
+    pool->inUse--;
+    allocStats.poolFrees++;
+}
+
+void poolReset(Pool* pool) {
+    pool->freeList = NULL;
+    for (PoolSlab* slab = pool->slabs; slab; slab = slab->next) {
+        threadSlab(pool, slab);
+    }
+    pool->inUse = 0;
+}
+
+void poolDestroy(Pool* pool) {
+    PoolSlab* slab = pool->slabs;
+    while (slab) {
+        PoolSlab* next = slab->next;
+        coreFree(slab);
+        slab = next;
+    }
+    pool->slabs = NULL;
+    pool->freeList = NULL;
+    pool->inUse = 0;
+}
+
+// ----------------------------
+// Arenas
+// ----------------------------
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t capacity;
+    size_t used;
+};
+
+static char* blockData(ArenaBlock* block) {
+    return (char*)block + ALIGN_UP(sizeof(ArenaBlock));
+}
+
+void arenaInit(Arena* arena, size_t blockSize) {
+    arena->first = arena->current = NULL;
+    arena->blockSize = blockSize ? blockSize : 64 * 1024;
+}
+
+void* arenaAlloc(Arena* arena, size_t size) {
+    size = ALIGN_UP(size ? size : 1);
+    // Try the current block, then any later blocks kept from before a reset
+    ArenaBlock* block = arena->current;
+    while (block && block->used + size > block->capacity) {
+        block = block->next;
+        if (block) block->used = 0;
+    }
+    if (!block) {
+        size_t capacity = size > arena->blockSize ? size : arena->blockSize;
+        block = (ArenaBlock*)coreMalloc(ALIGN_UP(sizeof(ArenaBlock)) + capacity);
+        if (!block) return NULL;
+        block->capacity = capacity;
+        block->used = 0;
+        // Append after the current block so a reset reuses it next time
+        if (arena->current) {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else {
+            block->next = arena->first;
+            arena->first = block;
+        }
+    }
+    arena->current = block;
+    void* ptr = blockData(block) + block->used;
+    block->used += size;
+    allocStats.arenaAllocs++;
+    return ptr;
+}
+
+void arenaReset(Arena* arena) {
+    arena->current = arena->first;
+    if (arena->first) arena->first->used = 0;
+}
+
+void arenaFree(Arena* arena) {
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        coreFree(block);
+        block = next;
+    }
+    arena->first = arena->current = NULL;
+}
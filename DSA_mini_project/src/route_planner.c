@@ -0,0 +1,189 @@
+#include <string.h>
+#include <time.h>
+#include "route_planner.h"
+#include "distance_matrix.h"
+#include "mempool.h"
+
+// Moves must save at least this much to count, so float noise can't cycle
+#define MIN_GAIN_KM 1e-4f
+
+typedef struct Planner {
+    int n;              // stops; node 0 is the depot, node k is areaIds[k-1]
+    float* legs;        // (n+1) x (n+1) leg lengths between nodes
+    int* tour;          // n+2 nodes, starting and ending at the depot
+    double deadline;
+    int timedOut;
+    int improvements;
+} Planner;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static inline float leg(const Planner* p, int a, int b) {
+    return p->legs[a * (p->n + 1) + b];
+}
+
+static int outOfTime(Planner* p) {
+    if (!p->timedOut && nowSeconds() >= p->deadline) p->timedOut = 1;
+    return p->timedOut;
+}
+
+static double tourKm(const Planner* p) {
+    double km = 0;
+    for (int i = 0; i <= p->n; i++) km += leg(p, p->tour[i], p->tour[i + 1]);
+    return km;
+}
+
+static void buildNearestNeighbour(Planner* p, char* visited) {
+    int at = 0;
+    p->tour[0] = 0;
+    for (int pos = 1; pos <= p->n; pos++) {
+        int best = -1;
+        float bestKm = 0;
+        for (int k = 1; k <= p->n; k++) {
+            if (visited[k]) continue;
+            float km = leg(p, at, k);
+            if (best < 0 || km < bestKm) best = k, bestKm = km;
+        }
+        visited[best] = 1;
+        p->tour[pos] = best;
+        at = best;
+    }
+    p->tour[p->n + 1] = 0;
+}
+
+static void reverse(int* tour, int i, int j) {
+    while (i < j) {
+        int t = tour[i];
+        tour[i++] = tour[j];
+        tour[j--] = t;
+    }
+}
+
+// One sweep of 2-opt: replaces edges (i-1,i) and (j,j+1) with (i-1,j) and
+// (i,j+1) whenever that is shorter. Returns 1 if anything changed.
+static int twoOptPass(Planner* p) {
+    int* t = p->tour;
+    int changed = 0;
+    for (int i = 1; i < p->n; i++) {
+        if (outOfTime(p)) return changed;
+        for (int j = i + 1; j <= p->n; j++) {
+            float delta = leg(p, t[i - 1], t[j]) + leg(p, t[i], t[j + 1])
+                        - leg(p, t[i - 1], t[i]) - leg(p, t[j], t[j + 1]);
+            if (delta < -MIN_GAIN_KM) {
+                reverse(t, i, j);
+                p->improvements++;
+                changed = 1;
+            }
+        }
+    }
+    return changed;
+}
+
+// Moves tour[i .. i+len-1] so it sits between tour[j] and tour[j+1]
+static void moveSegment(int* t, int i, int len, int j, int reversed) {
+    int seg[3];
+    for (int k = 0; k < len; k++) seg[k] = t[reversed ? i + len - 1 - k : i + k];
+    int at;
+    if (j < i) {
+        memmove(&t[j + 1 + len], &t[j + 1], (size_t)(i - j - 1) * sizeof(int));
+        at = j + 1;
+    } else {
+        memmove(&t[i], &t[i + len], (size_t)(j - i - len + 1) * sizeof(int));
+        at = j - len + 1;
+    }
+    memcpy(&t[at], seg, (size_t)len * sizeof(int));
+}
+
+// One sweep of Or-opt over runs of 1-3 stops. Returns 1 if anything changed.
+static int orOptPass(Planner* p) {
+    int* t = p->tour;
+    int changed = 0;
+    for (int len = 1; len <= 3 && len < p->n; len++) {
+        for (int i = 1; i + len - 1 <= p->n; i++) {
+            if (outOfTime(p)) return changed;
+            int first = t[i], last = t[i + len - 1];
+            int before = t[i - 1], after = t[i + len];
+            float removed = leg(p, before, first) + leg(p, last, after) - leg(p, before, after);
+            for (int j = 0; j <= p->n; j++) {
+                if (j >= i - 1 && j <= i + len - 1) continue;  // edges touching the run
+                int a = t[j], b = t[j + 1];
+                float base = leg(p, a, b);
+                float forward = leg(p, a, first) + leg(p, last, b) - base;
+                float backward = leg(p, a, last) + leg(p, first, b) - base;
+                int reversed = backward < forward;
+                float added = reversed ? backward : forward;
+                if (added - removed < -MIN_GAIN_KM) {
+                    moveSegment(t, i, len, j, reversed);
+                    p->improvements++;
+                    changed = 1;
+                    break;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+int planRoute(const int* areaIds, int count, long budgetMicros, int* order, RouteResult* result) {
+    return planRouteFrom(0.0f, 0.0f, areaIds, count, budgetMicros, order, result);
+}
+
+int planRouteFrom(float depotX, float depotY, const int* areaIds, int count,
+                  long budgetMicros, int* order, RouteResult* result) {
+    RouteResult local;
+    if (!result) result = &local;
+    memset(result, 0, sizeof(*result));
+    if (count <= 0) return 1;
+
+    Planner p;
+    memset(&p, 0, sizeof(p));
+    p.n = count;
+    int nodes = count + 1;
+    p.legs = (float*)coreMalloc((size_t)nodes * nodes * sizeof(float));
+    p.tour = (int*)coreMalloc((size_t)(count + 2) * sizeof(int));
+    char* visited = (char*)coreCalloc((size_t)nodes, 1);
+    if (!p.legs || !p.tour || !visited) {
+        coreFree(p.legs);
+        coreFree(p.tour);
+        coreFree(visited);
+        return 0;
+    }
+
+    const DistanceMatrix* matrix = distanceMatrixCurrent();
+    for (int a = 0; a < nodes; a++) {
+        p.legs[a * nodes + a] = 0.0f;
+        for (int b = a + 1; b < nodes; b++) {
+            float km = a == 0 ? areaKmFromPoint(depotX, depotY, areaIds[b - 1])
+                              : distanceMatrixLegKm(matrix, areaIds[a - 1], areaIds[b - 1]);
+            p.legs[a * nodes + b] = km;
+            p.legs[b * nodes + a] = km;
+        }
+    }
+
+    buildNearestNeighbour(&p, visited);
+    result->initialKm = tourKm(&p);
+
+    // Tours of one or two stops are the same length either way round
+    if (budgetMicros > 0 && count > 2) {
+        p.deadline = nowSeconds() + budgetMicros * 1e-6;
+        int improved = 1;
+        while (improved && !p.timedOut) {
+            improved = twoOptPass(&p);
+            improved |= orOptPass(&p);
+        }
+    }
+
+    for (int i = 0; i < count; i++) order[i] = areaIds[p.tour[i + 1] - 1];
+    result->km = tourKm(&p);
+    result->improvements = p.improvements;
+    result->timedOut = p.timedOut;
+
+    coreFree(p.legs);
+    coreFree(p.tour);
+    coreFree(visited);
+    return 1;
+}
@@ -0,0 +1,455 @@
+#include <string.h>
+#include <time.h>
+#include "simulator.h"
+#include "fleet.h"
+#include "area_table.h"
+#include "mempool.h"
+#include "log.h"
+
+#define MINUTES_PER_DAY 1440.0
+#define MIN_TRIP_MINUTES 30.0f      // a truck with less of its shift left stays in
+
+void simConfigDefaults(SimConfig* config) {
+    config->days = 7;
+    config->seed = 1;
+    config->tickMinutes = 60.0f;
+    config->minFillPerHour = 0.2f;
+    config->maxFillPerHour = 0.8f;
+    config->shiftStartMinutes = 6 * 60.0f;
+    config->dispatchMinutes = 30.0f;
+    config->unloadMinutes = 20.0f;
+    config->collectThreshold = 70;
+    config->topUpThreshold = 40;
+    config->planBudgetMicros = 2000;
+}
+
+// --------------------------------------------------------------
+// EVENT QUEUE
+// --------------------------------------------------------------
+typedef enum SimEventType {
+    SIM_SHIFT_START,
+    SIM_DISPATCH,
+    SIM_DEPART,
+    SIM_ARRIVE,
+    SIM_UNLOAD
+} SimEventType;
+
+typedef struct SimEvent {
+    double time;            // minutes since the start
+    unsigned long seq;      // first scheduled runs first among equal times
+    int type;
+    int target;             // fleet index for truck events
+} SimEvent;
+
+// Binary min-heap on (time, seq)
+typedef struct EventQueue {
+    SimEvent* items;
+    int count;
+    int capacity;
+    unsigned long nextSeq;
+} EventQueue;
+
+static int eventBefore(const SimEvent* a, const SimEvent* b) {
+    if (a->time != b->time) return a->time < b->time;
+    return a->seq < b->seq;
+}
+
+static int schedule(EventQueue* q, double time, int type, int target) {
+    if (q->count == q->capacity) {
+        int newCapacity = q->capacity ? q->capacity * 2 : 1024;
+        SimEvent* grown = (SimEvent*)coreRealloc(q->items, newCapacity * sizeof(SimEvent));
+        if (!grown) return 0;
+        q->items = grown;
+        q->capacity = newCapacity;
+    }
+    SimEvent ev = {time, q->nextSeq++, type, target};
+    int i = q->count++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!eventBefore(&ev, &q->items[parent])) break;
+        q->items[i] = q->items[parent];
+        i = parent;
+    }
+    q->items[i] = ev;
+    return 1;
+}
+
+static SimEvent popEvent(EventQueue* q) {
+    SimEvent top = q->items[0];
+    SimEvent last = q->items[--q->count];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= q->count) break;
+        if (child + 1 < q->count && eventBefore(&q->items[child + 1], &q->items[child])) child++;
+        if (!eventBefore(&q->items[child], &last)) break;
+        q->items[i] = q->items[child];
+        i = child;
+    }
+    if (q->count > 0) q->items[i] = last;
+    return top;
+}
+
+// Fill ticks all recur after the same interval, so they fall due in the
+// order they were scheduled; a FIFO ring keeps them (most of the events)
+// out of the heap
+typedef struct TickRing {
+    double* times;
+    int* slots;
+    int head;
+    int count;
+    int capacity;
+} TickRing;
+
+static void pushTick(TickRing* ring, double time, int slot) {
+    int i = ring->head + ring->count++;
+    if (i >= ring->capacity) i -= ring->capacity;
+    ring->times[i] = time;
+    ring->slots[i] = slot;
+}
+
+static int popTick(TickRing* ring) {
+    int slot = ring->slots[ring->head];
+    if (++ring->head == ring->capacity) ring->head = 0;
+    ring->count--;
+    return slot;
+}
+
+// --------------------------------------------------------------
+// SIMULATION STATE
+// --------------------------------------------------------------
+// A truck's current trip, copied out of the fleet plan. Bins are held by
+// storeSlot, which stays put while no bin is added or deleted.
+typedef struct SimTruck {
+    int busy;
+    double shiftEnd;
+    int stop;               // stop driven to next; stopCount means home
+    int stopCount;
+    int stopArea[MAX_DISPATCH_STOPS];
+    float legKm[MAX_DISPATCH_STOPS + 1];
+    int firstBin[MAX_DISPATCH_STOPS + 1];
+    int* binSlots;
+    int binCapacity;
+    float load;             // fill points on board
+} SimTruck;
+
+typedef struct Simulation {
+    const SimConfig* config;
+    SimKpis* kpis;
+    EventQueue events;
+    TickRing ticks;         // one pending tick per bin at most
+    double endTime;
+    int dispatchPending;
+    int truckCount;
+    SimTruck* trucks;
+    unsigned char* available;   // planFleetTrips options, per truck
+    float* minutesLeft;
+    // Per bin, by storeSlot
+    int slots;
+    float* fill;            // exact level; the core holds it rounded down
+    float* ratePerMinute;
+    double* lastFillTime;
+    double* overflowSince;  // when the bin reached 100%, -1 if it has not
+    unsigned char* reserved;    // on some truck's current trip
+} Simulation;
+
+// xorshift32: repeatable for a given seed, whatever rand() is doing
+static float nextUniform(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+static void closeOverflow(Simulation* sim, int slot, double now) {
+    if (sim->overflowSince[slot] < 0) return;
+    sim->kpis->overflowMinutes += now - sim->overflowSince[slot];
+    sim->overflowSince[slot] = -1.0;
+}
+
+// --------------------------------------------------------------
+// EVENT HANDLERS
+// --------------------------------------------------------------
+static int onFillTick(Simulation* sim, double now, int slot) {
+    Dustbin* bin = binAt(slot);
+    float level = sim->fill[slot] + sim->ratePerMinute[slot] * (float)(now - sim->lastFillTime[slot]);
+    sim->lastFillTime[slot] = now;
+    if (level >= 100.0f) {
+        level = 100.0f;
+        if (sim->overflowSince[slot] < 0) {
+            sim->overflowSince[slot] = now;
+            sim->kpis->overflows++;
+        }
+    }
+    sim->fill[slot] = level;
+    // Most reports move a bin by less than a whole percent
+    if ((int)level != bin->fillLevel) {
+        FillUpdate update = {bin->binID, (int)level};
+        applyFillUpdates(&update, 1, NULL, 0);
+    }
+    sim->kpis->fillTicks++;
+
+    double next = now + sim->config->tickMinutes;
+    if (next <= sim->endTime) pushTick(&sim->ticks, next, slot);
+    return 1;
+}
+
+static int onShiftStart(Simulation* sim, double now) {
+    for (int t = 0; t < sim->truckCount; t++) {
+        sim->trucks[t].shiftEnd = now + fleetTruck(t)->shiftMinutes;
+    }
+    if (!sim->dispatchPending) {
+        if (!schedule(&sim->events, now, SIM_DISPATCH, -1)) return 0;
+        sim->dispatchPending = 1;
+    }
+    double next = now + MINUTES_PER_DAY;
+    if (next > sim->endTime) return 1;
+    return schedule(&sim->events, next, SIM_SHIFT_START, -1);
+}
+
+static int acceptForTrip(const Dustbin* bin, void* userData) {
+    const Simulation* sim = (const Simulation*)userData;
+    return bin->fillLevel >= sim->config->collectThreshold && !sim->reserved[bin->storeSlot];
+}
+
+static int startTrip(Simulation* sim, const TruckTrip* trip, Dustbin** bins, double now) {
+    SimTruck* truck = &sim->trucks[trip->truck];
+    int first = trip->firstBin[0];
+    int count = trip->firstBin[trip->stopCount] - first;
+    if (count > truck->binCapacity) {
+        int* grown = (int*)coreRealloc(truck->binSlots, count * sizeof(int));
+        if (!grown) return 0;
+        truck->binSlots = grown;
+        truck->binCapacity = count;
+    }
+    truck->busy = 1;
+    truck->stop = 0;
+    truck->load = 0.0f;
+    truck->stopCount = trip->stopCount;
+    memcpy(truck->stopArea, trip->stopArea, trip->stopCount * sizeof(int));
+    memcpy(truck->legKm, trip->legKm, (trip->stopCount + 1) * sizeof(float));
+    for (int s = 0; s <= trip->stopCount; s++) truck->firstBin[s] = trip->firstBin[s] - first;
+    for (int i = 0; i < count; i++) {
+        int slot = bins[first + i]->storeSlot;
+        truck->binSlots[i] = slot;
+        sim->reserved[slot] = 1;
+    }
+    return schedule(&sim->events, now, SIM_DEPART, trip->truck);
+}
+
+// Idle trucks with enough shift left are planned over the bins that are
+// full enough and not already on a trip
+static int onDispatch(Simulation* sim, double now) {
+    sim->dispatchPending = 0;
+    int idle = 0;
+    int onShift = 0;
+    for (int t = 0; t < sim->truckCount; t++) {
+        float left = (float)(sim->trucks[t].shiftEnd - now);
+        sim->minutesLeft[t] = left;
+        sim->available[t] = !sim->trucks[t].busy && left >= MIN_TRIP_MINUTES;
+        idle += sim->available[t];
+        if (left - sim->config->dispatchMinutes >= MIN_TRIP_MINUTES) onShift = 1;
+    }
+
+    if (idle > 0) {
+        FleetPlanOptions options = {sim->available, sim->minutesLeft, acceptForTrip, sim};
+        FleetPlan plan;
+        planFleetTrips(sim->config->planBudgetMicros, &options, &plan);
+        for (int i = 0; i < plan.tripCount; i++) {
+            if (!startTrip(sim, &plan.trips[i], plan.bins, now)) return 0;
+        }
+    }
+
+    double next = now + sim->config->dispatchMinutes;
+    if (!onShift || next > sim->endTime) return 1;
+    sim->dispatchPending = 1;
+    return schedule(&sim->events, next, SIM_DISPATCH, -1);
+}
+
+static double driveMinutes(int t, float km) {
+    return km / fleetTruck(t)->speedKmph * 60.0;
+}
+
+static int onDepart(Simulation* sim, double now, int t) {
+    SimTruck* truck = &sim->trucks[t];
+    sim->kpis->departures++;
+    sim->kpis->kmDriven += truck->legKm[0];
+    return schedule(&sim->events, now + driveMinutes(t, truck->legKm[0]), SIM_ARRIVE, t);
+}
+
+static int collectBin(Simulation* sim, SimTruck* truck, int slot, double now) {
+    Dustbin* bin = binAt(slot);
+    sim->reserved[slot] = 0;
+    closeOverflow(sim, slot, now);
+    sim->fill[slot] = 0.0f;
+    sim->lastFillTime[slot] = now;
+    if (bin->fillLevel == 0) return 0;
+    truck->load += bin->fillLevel;
+    markBinCollectedAndRequeue(bin->binID);
+    return 1;
+}
+
+// At a stop the truck empties the bins it was sent for, then any other bin
+// of the area past topUpThreshold that it has room for, and drives on; back
+// at the depot it starts unloading
+static int onArrive(Simulation* sim, double now, int t) {
+    SimTruck* truck = &sim->trucks[t];
+    const Truck* spec = fleetTruck(t);
+    sim->kpis->arrivals++;
+    if (truck->stop == truck->stopCount) {
+        if (now > truck->shiftEnd + 0.01) sim->kpis->lateReturns++;
+        return schedule(&sim->events, now + sim->config->unloadMinutes, SIM_UNLOAD, t);
+    }
+
+    int collected = 0;
+    for (int i = truck->firstBin[truck->stop]; i < truck->firstBin[truck->stop + 1]; i++) {
+        collected += collectBin(sim, truck, truck->binSlots[i], now);
+    }
+    int threshold = sim->config->topUpThreshold;
+    if (threshold > 0) {
+        // Top-ups may only use time the rest of the trip doesn't need: the
+        // remaining legs and the planned bins at later stops
+        int stop = truck->stop;
+        double rest = (truck->firstBin[truck->stopCount] - truck->firstBin[stop + 1]) * spec->loadMinutes;
+        for (int s = stop + 1; s <= truck->stopCount; s++) rest += driveMinutes(t, truck->legKm[s]);
+        float room = spec->capacity * 100.0f;
+        for (Dustbin* bin = areaFirstBin(truck->stopArea[stop]); bin; bin = bin->areaNext) {
+            if (bin->fillLevel < threshold || sim->reserved[bin->storeSlot]) continue;
+            if (truck->load + bin->fillLevel > room) continue;
+            if (now + (collected + 1) * spec->loadMinutes + rest > truck->shiftEnd) break;
+            collected += collectBin(sim, truck, bin->storeSlot, now);
+        }
+    }
+    sim->kpis->binsCollected += collected;
+
+    float leg = truck->legKm[++truck->stop];
+    sim->kpis->kmDriven += leg;
+    double leave = now + collected * spec->loadMinutes;
+    return schedule(&sim->events, leave + driveMinutes(t, leg), SIM_ARRIVE, t);
+}
+
+static int onUnload(Simulation* sim, int t) {
+    sim->kpis->unloads++;
+    sim->trucks[t].busy = 0;
+    return 1;
+}
+
+// --------------------------------------------------------------
+// RUN
+// --------------------------------------------------------------
+static void freeSimulation(Simulation* sim) {
+    for (int t = 0; t < sim->truckCount && sim->trucks; t++) coreFree(sim->trucks[t].binSlots);
+    coreFree(sim->events.items);
+    coreFree(sim->ticks.times);
+    coreFree(sim->ticks.slots);
+    coreFree(sim->trucks);
+    coreFree(sim->available);
+    coreFree(sim->minutesLeft);
+    coreFree(sim->fill);
+    coreFree(sim->ratePerMinute);
+    coreFree(sim->lastFillTime);
+    coreFree(sim->overflowSince);
+    coreFree(sim->reserved);
+}
+
+static double wallSeconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int runSimulation(const SimConfig* config, SimKpis* kpis) {
+    memset(kpis, 0, sizeof(*kpis));
+    if (config->days <= 0 || config->tickMinutes <= 0 || config->dispatchMinutes <= 0) {
+        LOG_WARN("Simulation needs at least one day and positive intervals\n");
+        return 0;
+    }
+    int slots = binCount();
+    if (slots == 0) {
+        LOG_INFO("No bins to simulate!\n");
+        return 0;
+    }
+    if (fleetSize() == 0) fleetAddDefaultTrucks();
+
+    Simulation sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.config = config;
+    sim.kpis = kpis;
+    sim.endTime = config->days * MINUTES_PER_DAY;
+    sim.truckCount = fleetSize();
+    sim.slots = slots;
+    sim.trucks = (SimTruck*)coreCalloc(sim.truckCount, sizeof(SimTruck));
+    sim.available = (unsigned char*)coreMalloc(sim.truckCount);
+    sim.minutesLeft = (float*)coreMalloc(sim.truckCount * sizeof(float));
+    sim.fill = (float*)coreMalloc(slots * sizeof(float));
+    sim.ratePerMinute = (float*)coreMalloc(slots * sizeof(float));
+    sim.lastFillTime = (double*)coreMalloc(slots * sizeof(double));
+    sim.overflowSince = (double*)coreMalloc(slots * sizeof(double));
+    sim.reserved = (unsigned char*)coreCalloc(slots, 1);
+    sim.ticks.times = (double*)coreMalloc(slots * sizeof(double));
+    sim.ticks.slots = (int*)coreMalloc(slots * sizeof(int));
+    sim.ticks.capacity = slots;
+    if (!sim.ticks.times || !sim.ticks.slots || !sim.trucks || !sim.available || !sim.minutesLeft || !sim.fill || !sim.ratePerMinute ||
+        !sim.lastFillTime || !sim.overflowSince || !sim.reserved) {
+        LOG_ERROR("Memory allocation error (simulation)!\n");
+        freeSimulation(&sim);
+        return 0;
+    }
+
+    LOG_INFO("Simulating %d days: %d bins, %d trucks\n", config->days, slots, sim.truckCount);
+    double started = wallSeconds();
+
+    // Bins report at phases spread evenly over the first interval, in slot
+    // order, which keeps the tick ring in time order from the start
+    unsigned int rng = config->seed ? config->seed : 1;
+    for (int slot = 0; slot < slots; slot++) {
+        float perHour = config->minFillPerHour + (config->maxFillPerHour - config->minFillPerHour) * nextUniform(&rng);
+        sim.ratePerMinute[slot] = perHour / 60.0f;
+        sim.fill[slot] = (float)binAt(slot)->fillLevel;
+        sim.lastFillTime[slot] = 0.0;
+        sim.overflowSince[slot] = -1.0;
+        if (binAt(slot)->fillLevel >= 100) {
+            sim.overflowSince[slot] = 0.0;
+            kpis->overflows++;
+        }
+        pushTick(&sim.ticks, (slot + 0.5) * config->tickMinutes / slots, slot);
+    }
+    int ok = schedule(&sim.events, config->shiftStartMinutes, SIM_SHIFT_START, -1);
+
+    // Next event: the earlier of the tick ring and the heap, ticks first on a tie
+    while (ok) {
+        int tickDue = sim.ticks.count > 0 &&
+                      (sim.events.count == 0 || sim.ticks.times[sim.ticks.head] <= sim.events.items[0].time);
+        if (!tickDue && sim.events.count == 0) break;
+        double time = tickDue ? sim.ticks.times[sim.ticks.head] : sim.events.items[0].time;
+        if (time > sim.endTime) break;
+        kpis->events++;
+        if (tickDue) {
+            ok = onFillTick(&sim, time, popTick(&sim.ticks));
+            continue;
+        }
+        SimEvent ev = popEvent(&sim.events);
+        switch (ev.type) {
+            case SIM_SHIFT_START: ok = onShiftStart(&sim, ev.time); break;
+            case SIM_DISPATCH:    ok = onDispatch(&sim, ev.time); break;
+            case SIM_DEPART:      ok = onDepart(&sim, ev.time, ev.target); break;
+            case SIM_ARRIVE:      ok = onArrive(&sim, ev.time, ev.target); break;
+            case SIM_UNLOAD:      ok = onUnload(&sim, ev.target); break;
+        }
+    }
+    if (!ok) LOG_ERROR("Memory allocation error (simulation)!\n");
+
+    // Bins still full at the end count up to the end
+    for (int slot = 0; slot < slots; slot++) closeOverflow(&sim, slot, sim.endTime);
+    kpis->simulatedMinutes = sim.endTime;
+    kpis->wallSeconds = wallSeconds() - started;
+    kpis->eventsPerSecond = kpis->wallSeconds > 0 ? kpis->events / kpis->wallSeconds : 0;
+
+    LOG_INFO("Simulated %d days in %.2f s: %lu events, %ld bins collected, %.0f km, %.0f overflow bin-minutes\n",
+             config->days, kpis->wallSeconds, kpis->events, kpis->binsCollected, kpis->kmDriven,
+             kpis->overflowMinutes);
+    freeSimulation(&sim);
+    return ok;
+}
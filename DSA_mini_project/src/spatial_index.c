@@ -0,0 +1,272 @@
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "spatial_index.h"
+#include "core.h"
+#include "mempool.h"
+
+#define SPATIAL_MIN_CAPACITY 64
+
+static int cellCoord(float v) {
+    return (int)floorf(v / SPATIAL_CELL_KM);
+}
+
+static size_t cellHome(int cx, int cy, size_t mask) {
+    uint32_t h = (uint32_t)cx * 2654435769u ^ (uint32_t)cy * 40503u;
+    h ^= h >> 15;
+    return (size_t)h & mask;
+}
+
+static SpatialCell* findCell(const SpatialGrid* grid, int cx, int cy) {
+    if (grid->used == 0) return NULL;
+    size_t mask = grid->capacity - 1;
+    size_t i = cellHome(cx, cy, mask);
+    while (grid->cells[i].occupied) {
+        if (grid->cells[i].cx == cx && grid->cells[i].cy == cy) return &grid->cells[i];
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+static int rehash(SpatialGrid* grid, size_t newCapacity) {
+    SpatialCell* cells = (SpatialCell*)coreCalloc(newCapacity, sizeof(SpatialCell));
+    if (!cells) return 0;
+    size_t mask = newCapacity - 1;
+    for (size_t i = 0; i < grid->capacity; i++) {
+        if (!grid->cells[i].occupied) continue;
+        size_t j = cellHome(grid->cells[i].cx, grid->cells[i].cy, mask);
+        while (cells[j].occupied) j = (j + 1) & mask;
+        cells[j] = grid->cells[i];
+    }
+    coreFree(grid->cells);
+    grid->cells = cells;
+    grid->capacity = newCapacity;
+    return 1;
+}
+
+// Existing cell, or a new empty one (cells are only dropped by spatialClear)
+static SpatialCell* claimCell(SpatialGrid* grid, int cx, int cy) {
+    SpatialCell* cell = findCell(grid, cx, cy);
+    if (cell) return cell;
+    // Keep the load factor under 70%
+    if (grid->capacity == 0 || (grid->used + 1) * 10 >= grid->capacity * 7) {
+        size_t capacity = grid->capacity ? grid->capacity * 2 : SPATIAL_MIN_CAPACITY;
+        if (!rehash(grid, capacity)) return NULL;
+    }
+    size_t mask = grid->capacity - 1;
+    size_t i = cellHome(cx, cy, mask);
+    while (grid->cells[i].occupied) i = (i + 1) & mask;
+    cell = &grid->cells[i];
+    cell->cx = cx;
+    cell->cy = cy;
+    cell->occupied = 1;
+    cell->count = 0;
+    cell->first = NULL;
+    if (grid->used == 0) {
+        grid->minCx = grid->maxCx = cx;
+        grid->minCy = grid->maxCy = cy;
+    } else {
+        if (cx < grid->minCx) grid->minCx = cx;
+        if (cx > grid->maxCx) grid->maxCx = cx;
+        if (cy < grid->minCy) grid->minCy = cy;
+        if (cy > grid->maxCy) grid->maxCy = cy;
+    }
+    grid->used++;
+    return cell;
+}
+
+int spatialInsert(SpatialGrid* grid, Dustbin* bin) {
+    SpatialCell* cell = claimCell(grid, cellCoord(bin->x), cellCoord(bin->y));
+    if (!cell) return 0;
+    bin->gridPrev = NULL;
+    bin->gridNext = cell->first;
+    if (cell->first) cell->first->gridPrev = bin;
+    cell->first = bin;
+    cell->count++;
+    return 1;
+}
+
+void spatialRemove(SpatialGrid* grid, Dustbin* bin) {
+    SpatialCell* cell = findCell(grid, cellCoord(bin->x), cellCoord(bin->y));
+    if (!cell) return;
+    if (bin->gridPrev) bin->gridPrev->gridNext = bin->gridNext;
+    else cell->first = bin->gridNext;
+    if (bin->gridNext) bin->gridNext->gridPrev = bin->gridPrev;
+    bin->gridNext = bin->gridPrev = NULL;
+    cell->count--;
+}
+
+int spatialMove(SpatialGrid* grid, Dustbin* bin, float x, float y) {
+    if (cellCoord(x) == cellCoord(bin->x) && cellCoord(y) == cellCoord(bin->y)) {
+        bin->x = x;
+        bin->y = y;
+        return 1;
+    }
+    spatialRemove(grid, bin);
+    bin->x = x;
+    bin->y = y;
+    return spatialInsert(grid, bin);
+}
+
+// --------------------------------------------------------------
+// QUERIES
+// --------------------------------------------------------------
+static float squaredKm(const Dustbin* bin, float x, float y) {
+    float dx = bin->x - x, dy = bin->y - y;
+    return dx * dx + dy * dy;
+}
+
+// Squared distance from (x, y) to the nearest point of a cell
+static float cellSquaredKm(int cx, int cy, float x, float y) {
+    float left = cx * SPATIAL_CELL_KM, bottom = cy * SPATIAL_CELL_KM;
+    float dx = x < left ? left - x : (x > left + SPATIAL_CELL_KM ? x - left - SPATIAL_CELL_KM : 0.0f);
+    float dy = y < bottom ? bottom - y : (y > bottom + SPATIAL_CELL_KM ? y - bottom - SPATIAL_CELL_KM : 0.0f);
+    return dx * dx + dy * dy;
+}
+
+int spatialRadius(const SpatialGrid* grid, float x, float y, float radiusKm,
+                  SpatialFilter filter, void* userData, Dustbin** out, int max) {
+    if (grid->used == 0 || radiusKm < 0) return 0;
+    float limit = radiusKm * radiusKm;
+    int x0 = cellCoord(x - radiusKm), x1 = cellCoord(x + radiusKm);
+    int y0 = cellCoord(y - radiusKm), y1 = cellCoord(y + radiusKm);
+    if (x0 < grid->minCx) x0 = grid->minCx;
+    if (x1 > grid->maxCx) x1 = grid->maxCx;
+    if (y0 < grid->minCy) y0 = grid->minCy;
+    if (y1 > grid->maxCy) y1 = grid->maxCy;
+
+    int found = 0;
+    for (int cx = x0; cx <= x1; cx++) {
+        for (int cy = y0; cy <= y1; cy++) {
+            if (cellSquaredKm(cx, cy, x, y) > limit) continue;
+            const SpatialCell* cell = findCell(grid, cx, cy);
+            if (!cell) continue;
+            for (Dustbin* bin = cell->first; bin; bin = bin->gridNext) {
+                if (squaredKm(bin, x, y) > limit) continue;
+                if (filter && !filter(bin, userData)) continue;
+                if (found < max) out[found] = bin;
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+// k best so far, as a max-heap on squared distance
+typedef struct NearestHeap {
+    Dustbin** bins;
+    float* keys;
+    int count;
+    int k;
+    float limit;        // squared km; bins beyond it are never offered
+} NearestHeap;
+
+static void heapSwap(NearestHeap* h, int a, int b) {
+    Dustbin* bin = h->bins[a];
+    float key = h->keys[a];
+    h->bins[a] = h->bins[b];
+    h->keys[a] = h->keys[b];
+    h->bins[b] = bin;
+    h->keys[b] = key;
+}
+
+static void heapSiftDown(NearestHeap* h, int i, int count) {
+    for (;;) {
+        int largest = i, l = 2 * i + 1, r = l + 1;
+        if (l < count && h->keys[l] > h->keys[largest]) largest = l;
+        if (r < count && h->keys[r] > h->keys[largest]) largest = r;
+        if (largest == i) return;
+        heapSwap(h, i, largest);
+        i = largest;
+    }
+}
+
+static void heapOffer(NearestHeap* h, Dustbin* bin, float key) {
+    if (h->count < h->k) {
+        int i = h->count++;
+        h->bins[i] = bin;
+        h->keys[i] = key;
+        while (i > 0 && h->keys[(i - 1) / 2] < h->keys[i]) {
+            heapSwap(h, i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    } else if (key < h->keys[0]) {
+        h->bins[0] = bin;
+        h->keys[0] = key;
+        heapSiftDown(h, 0, h->count);
+    }
+}
+
+static void scanCell(const SpatialGrid* grid, int cx, int cy, float x, float y,
+                     SpatialFilter filter, void* userData, NearestHeap* h) {
+    if (cx < grid->minCx || cx > grid->maxCx || cy < grid->minCy || cy > grid->maxCy) return;
+    float cellKey = cellSquaredKm(cx, cy, x, y);
+    if (cellKey > h->limit || (h->count == h->k && cellKey >= h->keys[0])) return;
+    const SpatialCell* cell = findCell(grid, cx, cy);
+    if (!cell) return;
+    for (Dustbin* bin = cell->first; bin; bin = bin->gridNext) {
+        float key = squaredKm(bin, x, y);
+        if (key > h->limit || (h->count == h->k && key >= h->keys[0])) continue;
+        if (filter && !filter(bin, userData)) continue;
+        heapOffer(h, bin, key);
+    }
+}
+
+int spatialNearest(const SpatialGrid* grid, float x, float y, int k, float maxKm,
+                   SpatialFilter filter, void* userData, Dustbin** out, float* distKm) {
+    if (grid->used == 0 || k <= 0) return 0;
+    NearestHeap h = {out, distKm, 0, k, maxKm > 0 ? maxKm * maxKm : INFINITY};
+    if (!distKm) {
+        h.keys = (float*)coreMalloc((size_t)k * sizeof(float));
+        if (!h.keys) return 0;
+    }
+
+    int cx = cellCoord(x), cy = cellCoord(y);
+    // Rings closer than the occupied extent are empty, so start at its edge
+    int gapX = cx < grid->minCx ? grid->minCx - cx : (cx > grid->maxCx ? cx - grid->maxCx : 0);
+    int gapY = cy < grid->minCy ? grid->minCy - cy : (cy > grid->maxCy ? cy - grid->maxCy : 0);
+    int r = gapX > gapY ? gapX : gapY;
+    for (;; r++) {
+        if (r == 0) {
+            scanCell(grid, cx, cy, x, y, filter, userData, &h);
+        } else {
+            for (int dx = -r; dx <= r; dx++) {
+                scanCell(grid, cx + dx, cy - r, x, y, filter, userData, &h);
+                scanCell(grid, cx + dx, cy + r, x, y, filter, userData, &h);
+            }
+            for (int dy = -r + 1; dy <= r - 1; dy++) {
+                scanCell(grid, cx - r, cy + dy, x, y, filter, userData, &h);
+                scanCell(grid, cx + r, cy + dy, x, y, filter, userData, &h);
+            }
+        }
+        // Every cell of ring r + 1 is at least r cells away from (x, y)
+        float reach = r * SPATIAL_CELL_KM;
+        if (h.count == k && h.keys[0] <= reach * reach) break;
+        if (reach * reach > h.limit) break;
+        if (cx - r <= grid->minCx && cx + r >= grid->maxCx &&
+            cy - r <= grid->minCy && cy + r >= grid->maxCy) break;
+    }
+
+    // Heap order to nearest first
+    int found = h.count;
+    for (int end = found - 1; end > 0; end--) {
+        heapSwap(&h, 0, end);
+        heapSiftDown(&h, 0, end);
+    }
+    if (distKm) {
+        for (int i = 0; i < found; i++) distKm[i] = sqrtf(distKm[i]);
+    } else {
+        coreFree(h.keys);
+    }
+    return found;
+}
+
+void spatialClear(SpatialGrid* grid) {
+    if (grid->cells) memset(grid->cells, 0, grid->capacity * sizeof(SpatialCell));
+    grid->used = 0;
+}
+
+void spatialFree(SpatialGrid* grid) {
+    coreFree(grid->cells);
+    memset(grid, 0, sizeof(*grid));
+}
@@ -0,0 +1,621 @@
+// Core correctness checks, run by ctest.
+// Each check builds a fresh fleet, drives it through the public core API
+// and compares what the core structures report (ID index, priority heap,
+// distance trees, fill counters, batch updates) against a brute-force
+// model of the same bins. Exits non-zero and names the first failed check.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "core.h"
+#include "bin_index.h"
+#include "fleet.h"
+#include "distance_matrix.h"
+#include "simulator.h"
+#include "route_planner.h"
+#include "area_table.h"
+#include "log.h"
+
+static int failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        failures++; \
+    } \
+} while (0)
+
+static char areaNames[16][16];
+
+static void resetFleet(void) {
+    clearQueue();
+    clearPriorityQueue();
+    freeLinkedList();
+    freeAreaDistances();
+}
+
+// --------------------------------------------------------------
+// BRUTE-FORCE MODEL
+// --------------------------------------------------------------
+// The bins that should exist, with the fields the queues order by
+#define MAX_MODEL_BINS 4096
+
+typedef struct ModelBin {
+    int id;
+    float distance;
+    int fill;
+    int live;
+} ModelBin;
+
+static ModelBin model[MAX_MODEL_BINS];
+static int modelCount = 0;
+
+static ModelBin* modelFind(int id) {
+    for (int i = 0; i < modelCount; i++) {
+        if (model[i].live && model[i].id == id) return &model[i];
+    }
+    return NULL;
+}
+
+static int modelPriority(const ModelBin* b) {
+    return (int)(b->fill * 2 - b->distance * 5);
+}
+
+// Priority heap order: highest priority, then nearest, then lowest ID
+static int compareUrgent(const void* pa, const void* pb) {
+    const ModelBin* a = *(ModelBin* const*)pa;
+    const ModelBin* b = *(ModelBin* const*)pb;
+    if (modelPriority(a) != modelPriority(b)) return modelPriority(a) > modelPriority(b) ? -1 : 1;
+    if (a->distance != b->distance) return a->distance < b->distance ? -1 : 1;
+    return a->id < b->id ? -1 : a->id > b->id;
+}
+
+// Normal queue order: nearest, then lowest ID
+static int compareNormal(const void* pa, const void* pb) {
+    const ModelBin* a = *(ModelBin* const*)pa;
+    const ModelBin* b = *(ModelBin* const*)pb;
+    if (a->distance != b->distance) return a->distance < b->distance ? -1 : 1;
+    return a->id < b->id ? -1 : a->id > b->id;
+}
+
+static int modelAdd(int id, float distance, int fill) {
+    if (!addBin(id, areaNames[id % 16], distance, fill)) return 0;
+    ModelBin* b = &model[modelCount++];
+    b->id = id;
+    b->distance = distance;
+    b->fill = fill;
+    b->live = 1;
+    return 1;
+}
+
+// Both queues, the heap's peek and the fill counters against the model
+static void checkQueuesAgainstModel(void) {
+    static ModelBin* urgent[MAX_MODEL_BINS];
+    static ModelBin* normal[MAX_MODEL_BINS];
+    static Dustbin* snapshot[MAX_MODEL_BINS];
+    int urgentCount = 0, normalCount = 0, total = 0;
+    for (int i = 0; i < modelCount; i++) {
+        if (!model[i].live) continue;
+        total++;
+        if (model[i].fill >= 90) urgent[urgentCount++] = &model[i];
+        else normal[normalCount++] = &model[i];
+    }
+    qsort(urgent, urgentCount, sizeof(ModelBin*), compareUrgent);
+    qsort(normal, normalCount, sizeof(ModelBin*), compareNormal);
+
+    CHECK(binCount() == total);
+    CHECK(priorityQueueSize() == urgentCount);
+    CHECK(queueSize() == normalCount);
+
+    int n = priorityQueueSnapshot(snapshot, MAX_MODEL_BINS);
+    CHECK(n == urgentCount);
+    for (int i = 0; i < n && i < urgentCount; i++) CHECK(snapshot[i]->binID == urgent[i]->id);
+    if (urgentCount > 0) CHECK(priorityPeek() && priorityPeek()->binID == urgent[0]->id);
+
+    // A short snapshot is the head of the full one
+    if (urgentCount > 3) {
+        Dustbin* head3[3];
+        CHECK(priorityQueueSnapshot(head3, 3) == 3);
+        for (int i = 0; i < 3; i++) CHECK(head3[i]->binID == urgent[i]->id);
+    }
+
+    int i = 0;
+    for (Dustbin* bin = queueFront(); bin; bin = queueNextByDistance(bin), i++) {
+        CHECK(i < normalCount && bin->binID == normal[i]->id);
+        if (i >= normalCount) break;
+    }
+    CHECK(i == normalCount);
+    for (int r = 0; r < normalCount; r += 7) {
+        Dustbin* bin = queueBinAt(r);
+        CHECK(bin && bin->binID == normal[r]->id);
+        if (bin) CHECK(queueIndexOf(bin) == r);
+    }
+
+    FillSummary summary;
+    getFillSummary(&summary);
+    CHECK(summary.total == total);
+    CHECK(summary.urgent == urgentCount);
+    CHECK(summary.high + summary.medium + summary.low == normalCount);
+    CHECK(verifyFillCounters());
+}
+
+// --------------------------------------------------------------
+// CHECKS
+// --------------------------------------------------------------
+// Same hash as bin_index.c, to build IDs that share a home slot
+static size_t homeSlot(int id, size_t mask) {
+    uint32_t h = (uint32_t)id * 2654435769u;
+    h ^= h >> 16;
+    return (size_t)h & mask;
+}
+
+// Inserts, finds and deletes a probe cluster of colliding IDs, deleting
+// from the middle so backward shifting has to move later entries
+static void testIndexCollisions(void) {
+    enum { COLLIDING = 8 };
+    const size_t mask = 63;     // capacity the index reserves for 8..44 entries
+    static Dustbin bins[COLLIDING];
+    int ids[COLLIDING];
+    int found = 0;
+    for (int id = 1; found < COLLIDING; id++) {
+        if (homeSlot(id, mask) == 5) ids[found++] = id;
+    }
+
+    BinIndex index = {0};
+    CHECK(binIndexReserve(&index, 40));
+    CHECK(index.capacity == mask + 1);
+    for (int i = 0; i < COLLIDING; i++) {
+        bins[i].binID = ids[i];
+        CHECK(binIndexInsert(&index, &bins[i]));
+    }
+    CHECK(!binIndexInsert(&index, &bins[3]));   // duplicate
+    for (int i = 0; i < COLLIDING; i++) CHECK(binIndexFind(&index, ids[i]) == &bins[i]);
+
+    for (int i = 1; i < COLLIDING; i += 2) CHECK(binIndexRemove(&index, ids[i]));
+    CHECK(!binIndexRemove(&index, ids[1]));
+    for (int i = 0; i < COLLIDING; i++) {
+        CHECK(binIndexFind(&index, ids[i]) == (i % 2 ? NULL : &bins[i]));
+    }
+    CHECK(index.count == COLLIDING / 2);
+    binIndexFree(&index);
+
+    // The same through the core: colliding IDs among ordinary ones
+    resetFleet();
+    modelCount = 0;
+    for (int i = 0; i < COLLIDING; i++) CHECK(modelAdd(ids[i], 1.0f + i, 50));
+    for (int id = 1000; id < 1040; id++) CHECK(modelAdd(id, 2.0f, 30));
+    CHECK(!addBin(ids[0], areaNames[0], 1.0f, 10));     // duplicate ID refused
+    for (int i = 0; i < COLLIDING; i += 3) {
+        CHECK(deleteBin(ids[i]));
+        modelFind(ids[i])->live = 0;
+    }
+    CHECK(!deleteBin(ids[0]));
+    for (int i = 0; i < COLLIDING; i++) {
+        Dustbin* bin = findBinByID(ids[i]);
+        CHECK((bin != NULL) == (i % 3 != 0));
+        if (bin) CHECK(bin->binID == ids[i]);
+    }
+    checkQueuesAgainstModel();
+}
+
+// Random adds, fill changes and deletes; after each round the heap and the
+// red-black trees must serve exactly the brute-force order
+static void testServeOrder(void) {
+    resetFleet();
+    modelCount = 0;
+    srand(7);
+    int nextId = 1;
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 100; i++) {
+            // Few distinct distances and fills, so ties are common
+            modelAdd(nextId++, (float)(rand() % 20), 80 + rand() % 21);
+        }
+        for (int i = 0; i < 60; i++) {
+            ModelBin* b = &model[rand() % modelCount];
+            if (!b->live) continue;
+            b->fill = rand() % 101;
+            CHECK(updateFillLevel(b->id, b->fill));
+        }
+        for (int i = 0; i < 20; i++) {
+            ModelBin* b = &model[rand() % modelCount];
+            if (!b->live) continue;
+            CHECK(deleteBin(b->id));
+            b->live = 0;
+        }
+        checkQueuesAgainstModel();
+    }
+
+    // Collection empties a bin and sends it to the back of its queue order
+    for (int i = 0; i < modelCount; i++) {
+        if (!model[i].live || model[i].fill < 90) continue;
+        markBinCollectedAndRequeue(model[i].id);
+        model[i].fill = 0;
+    }
+    checkQueuesAgainstModel();
+}
+
+#define BATCH_FLEET 400
+
+static int notified[BATCH_FLEET];
+static int resets = 0;
+static int unorderedDuringNotify = 0;
+
+static void countChanges(BinChange change, const Dustbin* bin, void* userData) {
+    (void)userData;
+    if (change == BIN_RESET) {
+        resets++;
+        return;
+    }
+    notified[bin->binID]++;
+    // Queues are already in order when a listener runs
+    Dustbin* first;
+    if (priorityQueueSnapshot(&first, 1) == 1 && first != priorityPeek()) unorderedDuringNotify++;
+}
+
+// Duplicate IDs: the last reading wins, every bin lands in the queue its
+// final level calls for, and each bin is announced once. The fleet is big
+// enough for per-bin notifications; baseFill decides whether the batch
+// rebuilds the heap (few urgent bins) or sifts each reading (many).
+static void testBatchDuplicates(int baseFill) {
+    resetFleet();
+    modelCount = 0;
+    for (int id = 1; id < BATCH_FLEET; id++) modelAdd(id, (float)(id % 9), baseFill);
+
+    addBinChangeListener(countChanges, NULL);
+    memset(notified, 0, sizeof(notified));
+    resets = 0;
+    unorderedDuringNotify = 0;
+    FillUpdate updates[] = {
+        {3, 95}, {3, 97}, {4, 92}, {3, 40},     // 3 ends normal after two urgent readings
+        {5, 91}, {5, 99},                       // 5 ends urgent
+        {6, 20}, {6, 20},                       // repeated, same value
+        {7, 101},                               // out of range, skipped
+        {9999, 50},                             // unknown, skipped
+    };
+    FillTransition transitions[16];
+    size_t changed = applyFillUpdates(updates, sizeof(updates) / sizeof(updates[0]), transitions, 16);
+    removeBinChangeListener(countChanges, NULL);
+
+    modelFind(3)->fill = 40;
+    modelFind(4)->fill = 92;
+    modelFind(5)->fill = 99;
+    modelFind(6)->fill = 20;
+    CHECK(findBinByID(3)->fillLevel == 40);
+    CHECK(findBinByID(5)->fillLevel == 99);
+    CHECK(findBinByID(7)->fillLevel == baseFill);
+    CHECK(binInNormalQueue(findBinByID(3)) && !binInPriorityQueue(findBinByID(3)));
+    CHECK(binInPriorityQueue(findBinByID(4)) && binInPriorityQueue(findBinByID(5)));
+    checkQueuesAgainstModel();
+
+    // Transitions are per reading that crossed the line
+    if (baseFill < 90) CHECK(changed == 4);     // 3 up, 4 up, 3 down, 5 up
+    else CHECK(changed == 2);                   // 3 down, 6 down
+
+    CHECK(resets == 0);
+    CHECK(notified[3] == 1 && notified[4] == 1 && notified[5] == 1 && notified[6] == 1);
+    CHECK(notified[7] == 0 && notified[8] == 0);
+    CHECK(unorderedDuringNotify == 0);
+}
+
+// Area buckets and fill counters follow deletes and the fleet reset
+static void testResetWithoutQueueClears(void) {
+    for (int id = 1; id <= 500; id++) addBin(10000 + id, areaNames[id % 16], (float)(id % 13), id % 101);
+    // freeLinkedList alone must leave nothing pointing at released nodes
+    freeLinkedList();
+    CHECK(binCount() == 0);
+    CHECK(priorityQueueSize() == 0);
+    CHECK(queueSize() == 0);
+    CHECK(queueFront() == NULL && priorityPeek() == NULL);
+    CHECK(findBinByID(10001) == NULL);
+    modelCount = 0;
+    for (int id = 1; id <= 50; id++) modelAdd(id, (float)(id % 5), id * 2);
+    checkQueuesAgainstModel();
+}
+
+// One dispatch with short shifts: every truck is back within its shift and
+// capacity, nearby pickups included, and no bin is emptied twice
+static void testFleetDispatch(void) {
+    enum { BINS = 3000, TRUCKS = 6 };
+    static int before[BINS + 1];
+    resetFleet();
+    fleetClear();
+    srand(11);
+    for (int id = 1; id <= BINS; id++) {
+        int area = rand() % 16;
+        before[id] = rand() % 101;
+        addBin(id, areaNames[area], 1.0f + area * 0.75f, before[id]);
+    }
+    for (int t = 0; t < TRUCKS; t++) {
+        Truck truck = {0};
+        truck.id = t + 1;
+        truck.capacity = 40.0f;
+        truck.speedKmph = DEFAULT_TRUCK_SPEED_KMPH;
+        truck.shiftMinutes = 40.0f + 10.0f * t;
+        truck.loadMinutes = 0.5f;
+        CHECK(fleetAddTruck(&truck) == t);
+    }
+
+    int sent = dispatchFleet(0);
+    CHECK(sent > 0);
+    int collected = 0;
+    float capacity = 0.0f;
+    for (int i = 0; i < getDispatchSummaryCount(); i++) {
+        const DispatchSummary* s = getDispatchSummary(i);
+        const Truck* truck = fleetTruck(s->truckID - 1);
+        CHECK(s->totalTimeMinutes <= truck->shiftMinutes + 0.01f);
+        collected += s->binsCollected;
+        capacity += truck->capacity * 100.0f;
+    }
+    int emptied = 0;
+    long fillRemoved = 0;
+    for (int id = 1; id <= BINS; id++) {
+        if (before[id] > 0 && findBinByID(id)->fillLevel == 0) {
+            emptied++;
+            fillRemoved += before[id];
+        }
+    }
+    CHECK(emptied == collected);
+    CHECK(fillRemoved <= capacity);
+    CHECK(verifyFillCounters());
+    fleetClear();
+}
+
+// Replaces the file at path with size bytes of data
+static int writeFile(const char* path, const void* data, size_t size) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    int ok = fwrite(data, 1, size, file) == size;
+    return fclose(file) == 0 && ok;
+}
+
+// A saved matrix maps back. Damaged copies are refused instead of being
+// read past their end: a name record without a terminator, a truncated
+// file, a cells offset that wraps around, more name records than bytes.
+static void testMatrixFiles(void) {
+    const char* path = "test_core_matrix.bin";
+    resetFleet();
+    for (int id = 1; id <= 32; id++) addBin(id, areaNames[id % 16], 1.0f + (id % 16), 50);
+    CHECK(distanceMatrixSave(path));
+    CHECK(distanceMatrixMap(path));
+    distanceMatrixFree();
+
+    static char saved[4096];
+    FILE* file = fopen(path, "rb");
+    CHECK(file != NULL);
+    if (!file) return;
+    size_t size = fread(saved, 1, sizeof(saved), file);
+    fclose(file);
+    CHECK(size > 64 + 16 * 50 && size < sizeof(saved));
+
+    // Header: magic[8], areas, nameBytes, cellsOffset at byte 16; the name
+    // records follow the 64-byte header
+    static char damaged[4096];
+    memcpy(damaged, saved, size);
+    memset(damaged + 64, 'x', 50);
+    CHECK(writeFile(path, damaged, size));
+    CHECK(!distanceMatrixMap(path));
+    CHECK(distanceMatrixOpen(path) == 0);
+
+    CHECK(writeFile(path, saved, size - 4));
+    CHECK(!distanceMatrixMap(path));
+
+    memcpy(damaged, saved, size);
+    // A multiple of 64 that the cells' size carries back round into the file
+    uint32_t savedAreas;
+    memcpy(&savedAreas, saved + 8, sizeof(savedAreas));
+    uint64_t offset = 0 - (((uint64_t)savedAreas * (savedAreas - 1) / 2 * sizeof(float)) & ~(uint64_t)63);
+    memcpy(damaged + 16, &offset, sizeof(offset));
+    CHECK(writeFile(path, damaged, size));
+    CHECK(!distanceMatrixMap(path));
+
+    memcpy(damaged, saved, size);
+    uint32_t areas = DISTANCE_MATRIX_MAX_AREAS;
+    offset = 0 - (uint64_t)DISTANCE_MATRIX_MAX_AREAS * (DISTANCE_MATRIX_MAX_AREAS - 1) / 2 * sizeof(float);
+    memcpy(damaged + 8, &areas, sizeof(areas));
+    memcpy(damaged + 16, &offset, sizeof(offset));
+    CHECK(writeFile(path, damaged, size));
+    CHECK(!distanceMatrixMap(path));
+
+    CHECK(writeFile(path, saved, size));
+    CHECK(distanceMatrixMap(path));
+    distanceMatrixFree();
+    remove(path);
+}
+
+// A CSV that leaves a pair out still gives a number for it, the planar
+// estimate, also when its areas line up with the running table's ids
+static void testMatrixCsvGaps(void) {
+    const char* path = "test_core_matrix.csv";
+    static const char csv[] = "A,B,1.5\nB,C,2.5\n";
+    resetFleet();
+    CHECK(addBin(1, "A", 1.0f, 50));
+    CHECK(addBin(2, "B", 2.0f, 50));
+    CHECK(addBin(3, "C", 3.0f, 50));
+    CHECK(writeFile(path, csv, sizeof(csv) - 1));
+    CHECK(distanceMatrixLoadCsv(path));
+
+    int a = areaLookup("A"), b = areaLookup("B"), c = areaLookup("C");
+    CHECK(distanceMatrixKm(a, b) == 1.5f && distanceMatrixKm(b, a) == 1.5f);
+    CHECK(distanceMatrixKm(b, c) == 2.5f);
+    float ac = distanceMatrixKm(a, c);
+    CHECK(!isnan(ac) && ac == areaTravelKm(a, c));
+    distanceMatrixFree();
+    remove(path);
+}
+
+// A few simulated days: trucks collect, every trip is back within its
+// shift (top-ups at stops included) and the counters survive the run
+static void testSimulation(void) {
+    resetFleet();
+    fleetClear();
+    srand(5);
+    for (int id = 1; id <= 5000; id++) {
+        int area = rand() % 16;
+        addBin(id, areaNames[area], 1.0f + area * 1.5f, rand() % 101);
+    }
+    for (int t = 0; t < 4; t++) {
+        Truck truck = {0};
+        truck.id = t + 1;
+        truck.capacity = 100.0f;
+        truck.speedKmph = DEFAULT_TRUCK_SPEED_KMPH;
+        truck.shiftMinutes = 240.0f;
+        truck.loadMinutes = 1.0f;
+        CHECK(fleetAddTruck(&truck) == t);
+    }
+
+    SimConfig config;
+    simConfigDefaults(&config);
+    config.days = 4;
+    SimKpis kpis;
+    CHECK(runSimulation(&config, &kpis));
+    CHECK(kpis.departures > 0 && kpis.binsCollected > 0);
+    CHECK(kpis.unloads <= kpis.departures && kpis.departures <= kpis.unloads + 4);
+    CHECK(kpis.lateReturns == 0);
+    CHECK(binCount() == 5000);
+    CHECK(verifyFillCounters());
+    fleetClear();
+}
+
+// Radius and k-nearest queries against a scan of every bin, after bins
+// were added at survey positions, moved and deleted
+static int acceptEvenIds(const Dustbin* bin, void* userData) {
+    (void)userData;
+    return bin->binID % 2 == 0;
+}
+
+static int compareFloats(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return x < y ? -1 : x > y;
+}
+
+static void testSpatialQueries(void) {
+    enum { BINS = 2000, QUERIES = 200, K = 8 };
+    static Dustbin* found[BINS];
+    static float scanKm[BINS];
+    resetFleet();
+    srand(3);
+    for (int id = 1; id <= BINS; id++) {
+        float x = (float)(rand() % 10000) / 1000.0f - 5.0f;
+        float y = (float)(rand() % 10000) / 1000.0f - 5.0f;
+        CHECK(addBinAt(id, areaNames[id % 16], 1.0f, 50, x, y));
+    }
+    for (int id = 1; id <= BINS; id += 7) CHECK(moveBin(id, -(findBinByID(id)->x), findBinByID(id)->y + 0.3f));
+    for (int id = 5; id <= BINS; id += 11) CHECK(deleteBin(id));
+
+    for (int q = 0; q < QUERIES; q++) {
+        float x = (float)(rand() % 12000) / 1000.0f - 6.0f;
+        float y = (float)(rand() % 12000) / 1000.0f - 6.0f;
+        float radius = 0.1f + (float)(rand() % 2000) / 1000.0f;
+        int filtered = q % 2;
+
+        // Bins within a hair of the radius may fall either way
+        int inside = 0, border = 0, scanned = 0;
+        for (int id = 1; id <= BINS; id++) {
+            Dustbin* bin = findBinByID(id);
+            if (!bin || (filtered && !acceptEvenIds(bin, NULL))) continue;
+            float km = sqrtf((bin->x - x) * (bin->x - x) + (bin->y - y) * (bin->y - y));
+            scanKm[scanned++] = km;
+            if (fabsf(km - radius) < 1e-4f) border++;
+            else if (km < radius) inside++;
+        }
+        int n = findBinsWithinRadius(x, y, radius, filtered ? acceptEvenIds : NULL, NULL, found, BINS);
+        CHECK(n >= inside && n <= inside + border);
+        for (int i = 0; i < n; i++) {
+            float km = sqrtf((found[i]->x - x) * (found[i]->x - x) + (found[i]->y - y) * (found[i]->y - y));
+            CHECK(km <= radius + 1e-4f);
+            if (filtered) CHECK(acceptEvenIds(found[i], NULL));
+        }
+
+        float nearKm[K];
+        qsort(scanKm, scanned, sizeof(float), compareFloats);
+        int k = findNearestBins(x, y, K, 0.0f, filtered ? acceptEvenIds : NULL, NULL, found, nearKm);
+        CHECK(k == (scanned < K ? scanned : K));
+        for (int i = 0; i < k; i++) {
+            CHECK(fabsf(nearKm[i] - scanKm[i]) < 1e-3f);
+            if (filtered) CHECK(acceptEvenIds(found[i], NULL));
+        }
+
+        // Limited to the radius: the nearest of the bins inside it
+        k = findNearestBins(x, y, K, radius, filtered ? acceptEvenIds : NULL, NULL, found, nearKm);
+        CHECK(k >= (inside < K ? inside : K) && k <= (inside + border < K ? inside + border : K));
+        for (int i = 0; i < k; i++) {
+            CHECK(nearKm[i] <= radius + 1e-4f);
+            CHECK(fabsf(nearKm[i] - scanKm[i]) < 1e-3f);
+        }
+    }
+}
+
+// Planned tours visit every stop once, report the length they really have
+// and are never longer than the nearest-neighbour tour they started from
+static double tourLength(const int* order, int count) {
+    double km = areaKmFromPoint(0.0f, 0.0f, order[0]) + areaKmFromPoint(0.0f, 0.0f, order[count - 1]);
+    for (int i = 1; i < count; i++) km += distanceMatrixKm(order[i - 1], order[i]);
+    return km;
+}
+
+static void testRoutePlanner(void) {
+    enum { AREAS = 48 };
+    static const int sizes[] = { 1, 2, 3, 6, 12, 30, AREAS };
+    char names[AREAS][16];
+    int ids[AREAS];
+    resetFleet();
+    for (int a = 0; a < AREAS; a++) {
+        snprintf(names[a], sizeof(names[a]), "Route%02d", a);
+        CHECK(addBin(a + 1, names[a], 0.5f + (float)(a * 7 % 23), 50));
+        ids[a] = areaLookup(names[a]);
+        CHECK(ids[a] >= 0);
+    }
+
+    for (size_t c = 0; c < sizeof(sizes) / sizeof(sizes[0]); c++) {
+        int n = sizes[c];
+        for (long budget = 0; budget <= 20000; budget += 20000) {
+            int order[AREAS];
+            RouteResult result;
+            CHECK(planRoute(ids, n, budget, order, &result));
+
+            char seen[AREAS] = {0};
+            for (int i = 0; i < n; i++) {
+                int at = -1;
+                for (int a = 0; a < n; a++) {
+                    if (ids[a] == order[i]) at = a;
+                }
+                CHECK(at >= 0 && !seen[at]);
+                if (at >= 0) seen[at] = 1;
+            }
+            double km = tourLength(order, n);
+            CHECK(fabs(km - result.km) <= 1e-3 * (1.0 + km));
+            CHECK(result.km <= result.initialKm + 1e-3);
+            if (budget == 0) CHECK(result.improvements == 0 && result.km == result.initialKm);
+        }
+    }
+}
+
+int main(void) {
+    FILE* devnull = fopen("/dev/null", "w");
+    if (devnull) logSetOutput(devnull);
+    for (int i = 0; i < 16; i++) snprintf(areaNames[i], sizeof(areaNames[i]), "Area%02d", i);
+
+    testIndexCollisions();
+    testServeOrder();
+    testBatchDuplicates(50);
+    testBatchDuplicates(95);
+    testResetWithoutQueueClears();
+    testSpatialQueries();
+    testRoutePlanner();
+    testFleetDispatch();
+    testSimulation();
+    testMatrixFiles();
+    testMatrixCsvGaps();
+
+    resetFleet();
+    logFlush();
+    logSetOutput(NULL);
+    if (devnull) fclose(devnull);
+    if (failures) {
+        fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("test_core: all checks passed\n");
+    return 0;
+}